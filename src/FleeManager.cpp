@@ -5,6 +5,9 @@
 
 #include "FleeManager.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "Playerbots.h"
 #include "ServerFacade.h"
 
@@ -18,26 +21,61 @@ FleeManager::FleeManager(Player* bot, float maxAllowedDistance, float followAngl
 {
 }
 
-void FleeManager::calculateDistanceToCreatures(FleePoint* point)
+void FleeSearch::Clear()
 {
-    point->minDistance = -1.0f;
-    point->sumDistance = 0.0f;
-    PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
-    if (!botAI)
+    enemyX.clear();
+    enemyY.clear();
+    enemySize.clear();
+    enemyOri.clear();
+    x.clear();
+    y.clear();
+    sumDistance.clear();
+    minDistance.clear();
+    order.clear();
+}
+
+void FleeManager::calculateDistanceToCreatures(FleeSearch& search, float x, float y, float& sumDistance,
+                                               float& minDistance)
+{
+    minDistance = -1.0f;
+    sumDistance = 0.0f;
+    for (size_t i = 0; i < search.enemyX.size(); ++i)
     {
-        return;
+        float dx = search.enemyX[i] - x;
+        float dy = search.enemyY[i] - y;
+        float d = std::max(0.0f, std::sqrt(dx * dx + dy * dy) - search.enemySize[i]);
+        d = std::round(d * 10.0f) / 10.0f;
+        sumDistance += d;
+        if (minDistance < 0 || minDistance > d)
+            minDistance = d;
     }
-    GuidVector units = *botAI->GetAiObjectContext()->GetValue<GuidVector>("possible targets no los");
-    for (GuidVector::iterator i = units.begin(); i != units.end(); ++i)
-    {
-        Unit* unit = botAI->GetUnit(*i);
-        if (!unit)
-            continue;
+}
 
-        float d = sServerFacade->GetDistance2d(unit, point->x, point->y);
-        point->sumDistance += d;
-        if (point->minDistance < 0 || point->minDistance > d)
-            point->minDistance = d;
+void FleeManager::calculateDistanceToCreatures(FleeSearch& search)
+{
+    size_t count = search.x.size();
+    search.sumDistance.assign(count, 0.0f);
+    search.minDistance.assign(count, -1.0f);
+
+    // enemy by enemy over all candidates, so the inner loop only touches contiguous floats
+    float* candidateX = search.x.data();
+    float* candidateY = search.y.data();
+    float* sumDistance = search.sumDistance.data();
+    float* minDistance = search.minDistance.data();
+    for (size_t e = 0; e < search.enemyX.size(); ++e)
+    {
+        float enemyX = search.enemyX[e];
+        float enemyY = search.enemyY[e];
+        float enemySize = search.enemySize[e];
+        for (size_t i = 0; i < count; ++i)
+        {
+            float dx = enemyX - candidateX[i];
+            float dy = enemyY - candidateY[i];
+            float d = std::max(0.0f, std::sqrt(dx * dx + dy * dy) - enemySize);
+            d = std::round(d * 10.0f) / 10.0f;
+            sumDistance[i] += d;
+            minDistance[i] = (minDistance[i] < 0 || minDistance[i] > d) ? d : minDistance[i];
+        }
     }
 }
 
@@ -53,23 +91,17 @@ bool intersectsOri(float angle, std::vector<float>& angles, float angleIncrement
     return false;
 }
 
-void FleeManager::calculatePossibleDestinations(std::vector<FleePoint*>& points)
+void FleeManager::calculatePossibleDestinations(FleeSearch& search)
 {
     PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
     if (!botAI)
     {
         return;
     }
-    Unit* target = *botAI->GetAiObjectContext()->GetValue<Unit*>("current target");
 
     float botPosX = startPosition.getX();
     float botPosY = startPosition.getY();
-    float botPosZ = startPosition.getZ();
-
-    FleePoint start(botAI, botPosX, botPosY, botPosZ);
-    calculateDistanceToCreatures(&start);
 
-    std::vector<float> enemyOri;
     GuidVector units = *botAI->GetAiObjectContext()->GetValue<GuidVector>("possible targets no los");
     for (GuidVector::iterator i = units.begin(); i != units.end(); ++i)
     {
@@ -77,10 +109,13 @@ void FleeManager::calculatePossibleDestinations(std::vector<FleePoint*>& points)
         if (!unit)
             continue;
 
-        float ori = bot->GetAngle(unit);
-        enemyOri.push_back(ori);
+        search.enemyX.push_back(unit->GetPositionX());
+        search.enemyY.push_back(unit->GetPositionY());
+        search.enemySize.push_back(unit->GetObjectSize());
+        search.enemyOri.push_back(bot->GetAngle(unit));
     }
 
+    // only geometry here, map and line of sight checks are left for the best scored candidates
     float distIncrement = std::max(sPlayerbotAIConfig->followDistance,
                                    (maxAllowedDistance - sPlayerbotAIConfig->tooCloseDistance) / 10.0f);
     for (float dist = maxAllowedDistance; dist >= sPlayerbotAIConfig->tooCloseDistance; dist -= distIncrement)
@@ -91,84 +126,88 @@ void FleeManager::calculatePossibleDestinations(std::vector<FleePoint*>& points)
             for (float angle = add; angle < add + 2 * static_cast<float>(M_PI) + angleIncrement;
                  angle += static_cast<float>(M_PI) / 4)
             {
-                if (intersectsOri(angle, enemyOri, angleIncrement))
+                if (intersectsOri(angle, search.enemyOri, angleIncrement))
                     continue;
 
-                float x = botPosX + cos(angle) * maxAllowedDistance, y = botPosY + sin(angle) * maxAllowedDistance,
-                      z = botPosZ + CONTACT_DISTANCE;
+                float x = botPosX + cos(angle) * maxAllowedDistance, y = botPosY + sin(angle) * maxAllowedDistance;
                 if (forceMaxDistance &&
                     sServerFacade->IsDistanceLessThan(sServerFacade->GetDistance2d(bot, x, y),
                                                       maxAllowedDistance - sPlayerbotAIConfig->tooCloseDistance))
                     continue;
 
-                bot->UpdateAllowedPositionZ(x, y, z);
-
-                Map* map = startPosition.getMap();
-                if (map && map->IsInWater(bot->GetPhaseMask(), x, y, z, bot->GetCollisionHeight()))
-                    continue;
-
-                if (!bot->IsWithinLOS(x, y, z) || (target && !target->IsWithinLOS(x, y, z)))
-                    continue;
-
-                FleePoint* point = new FleePoint(botAI, x, y, z);
-                calculateDistanceToCreatures(point);
-
-                if (sServerFacade->IsDistanceGreaterOrEqualThan(point->minDistance - start.minDistance,
-                                                                sPlayerbotAIConfig->followDistance))
-                    points.push_back(point);
-                else
-                    delete point;
+                search.x.push_back(x);
+                search.y.push_back(y);
             }
         }
     }
-}
 
-void FleeManager::cleanup(std::vector<FleePoint*>& points)
-{
-    for (std::vector<FleePoint*>::iterator i = points.begin(); i != points.end(); i++)
+    float startSumDistance, startMinDistance;
+    calculateDistanceToCreatures(search, botPosX, botPosY, startSumDistance, startMinDistance);
+    calculateDistanceToCreatures(search);
+
+    for (uint32 i = 0; i < search.x.size(); ++i)
     {
-        delete *i;
+        if (sServerFacade->IsDistanceGreaterOrEqualThan(search.minDistance[i] - startMinDistance,
+                                                        sPlayerbotAIConfig->followDistance))
+            search.order.push_back(i);
     }
 
-    points.clear();
+    // most distance to all enemies first, earlier candidates first among equals
+    std::stable_sort(search.order.begin(), search.order.end(),
+                     [&search](uint32 left, uint32 right)
+                     { return search.sumDistance[left] > search.sumDistance[right]; });
 }
 
-bool FleeManager::isBetterThan(FleePoint* point, FleePoint* other)
+bool FleeManager::isReachable(float x, float y, float& z, Unit* target)
 {
-    return point->sumDistance - other->sumDistance > 0;
-}
+    bot->UpdateAllowedPositionZ(x, y, z);
 
-FleePoint* FleeManager::selectOptimalDestination(std::vector<FleePoint*>& points)
-{
-    FleePoint* best = nullptr;
-    for (std::vector<FleePoint*>::iterator i = points.begin(); i != points.end(); i++)
-    {
-        FleePoint* point = *i;
-        if (!best || isBetterThan(point, best))
-            best = point;
-    }
+    Map* map = startPosition.getMap();
+    if (map && map->IsInWater(bot->GetPhaseMask(), x, y, z, bot->GetCollisionHeight()))
+        return false;
 
-    return best;
+    return bot->IsWithinLOS(x, y, z) && (!target || target->IsWithinLOS(x, y, z));
 }
 
 bool FleeManager::CalculateDestination(float* rx, float* ry, float* rz)
 {
-    std::vector<FleePoint*> points;
-    calculatePossibleDestinations(points);
-
-    FleePoint* point = selectOptimalDestination(points);
-    if (!point)
+    PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
+    if (!botAI)
     {
-        cleanup(points);
         return false;
     }
 
-    *rx = point->x;
-    *ry = point->y;
-    *rz = point->z;
+    thread_local FleeSearch search;
+    search.Clear();
+    calculatePossibleDestinations(search);
+
+    Unit* target = *botAI->GetAiObjectContext()->GetValue<Unit*>("current target");
+
+    // the first reachable candidate in score order is the best one
+    bool checked = false;
+    float lastX = 0.0f, lastY = 0.0f;
+    for (uint32 i : search.order)
+    {
+        float x = search.x[i];
+        float y = search.y[i];
+        if (checked && x == lastX && y == lastY)
+            continue;
+
+        checked = true;
+        lastX = x;
+        lastY = y;
+
+        float z = startPosition.getZ() + CONTACT_DISTANCE;
+        if (!isReachable(x, y, z, target))
+            continue;
+
+        *rx = x;
+        *ry = y;
+        *rz = z;
+        return true;
+    }
 
-    cleanup(points);
-    return true;
+    return false;
 }
 
 bool FleeManager::isUseful()
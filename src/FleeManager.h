@@ -13,24 +13,25 @@
 
 class Player;
 class PlayerbotAI;
+class Unit;
 
-class FleePoint
+// Enemies and destination candidates of a flee search, one array per field so scoring every candidate
+// against every enemy runs over flat arrays. Buffers are reused between searches of the same thread.
+struct FleeSearch
 {
-public:
-    FleePoint(PlayerbotAI* botAI, float x, float y, float z)
-        : botAI(botAI), sumDistance(0.0f), minDistance(0.0f), x(x), y(y), z(z)
-    {
-    }
+    void Clear();
 
-    float x;
-    float y;
-    float z;
+    std::vector<float> enemyX;
+    std::vector<float> enemyY;
+    std::vector<float> enemySize;
+    std::vector<float> enemyOri;
 
-    float sumDistance;
-    float minDistance;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> sumDistance;
+    std::vector<float> minDistance;
 
-private:
-    PlayerbotAI* botAI;
+    std::vector<uint32> order;
 };
 
 class FleeManager
@@ -43,11 +44,10 @@ public:
     bool isUseful();
 
 private:
-    void calculatePossibleDestinations(std::vector<FleePoint*>& points);
-    void calculateDistanceToCreatures(FleePoint* point);
-    void cleanup(std::vector<FleePoint*>& points);
-    FleePoint* selectOptimalDestination(std::vector<FleePoint*>& points);
-    bool isBetterThan(FleePoint* point, FleePoint* other);
+    void calculatePossibleDestinations(FleeSearch& search);
+    void calculateDistanceToCreatures(FleeSearch& search);
+    void calculateDistanceToCreatures(FleeSearch& search, float x, float y, float& sumDistance, float& minDistance);
+    bool isReachable(float x, float y, float& z, Unit* target);
 
     Player* bot;
     float maxAllowedDistance;
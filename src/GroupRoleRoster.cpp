@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "GroupRoleRoster.h"
+
+#include "AiFactory.h"
+#include "Group.h"
+#include "Player.h"
+#include "PlayerbotAI.h"
+#include "Timer.h"
+
+uint8 GroupRoleRoster::GetSpecTab(Player* player)
+{
+    SpecTab current;
+    current.level = player->GetLevel();
+    current.spec = player->GetActiveSpec();
+    current.talentPoints = player->GetFreeTalentPoints();
+    current.talents = player->GetTalentMap().size();
+
+    {
+        std::lock_guard<std::mutex> guard(specTabsLock);
+        std::unordered_map<ObjectGuid, SpecTab>::iterator i = specTabs.find(player->GetGUID());
+        if (i != specTabs.end() && i->second.level == current.level && i->second.spec == current.spec &&
+            i->second.talentPoints == current.talentPoints && i->second.talents == current.talents)
+            return i->second.tab;
+    }
+
+    current.tab = AiFactory::GetPlayerSpecTab(player);
+
+    std::lock_guard<std::mutex> guard(specTabsLock);
+    specTabs[player->GetGUID()] = current;
+    return current.tab;
+}
+
+bool GroupRoleRoster::GetMember(Group* group, Player* player, GroupRosterMember& member)
+{
+    std::lock_guard<std::mutex> guard(rostersLock);
+    Roster& roster = GetRoster(group);
+    for (GroupRosterMember const& rosterMember : roster.members)
+    {
+        if (rosterMember.guid == player->GetGUID())
+        {
+            member = rosterMember;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ObjectGuid GroupRoleRoster::GetHealer(Group* group, uint32 index)
+{
+    std::lock_guard<std::mutex> guard(rostersLock);
+    Roster& roster = GetRoster(group);
+    return index < roster.healers.size() ? roster.healers[index] : ObjectGuid::Empty;
+}
+
+ObjectGuid GroupRoleRoster::GetRangedDps(Group* group, uint32 index)
+{
+    std::lock_guard<std::mutex> guard(rostersLock);
+    Roster& roster = GetRoster(group);
+    return index < roster.rangedDps.size() ? roster.rangedDps[index] : ObjectGuid::Empty;
+}
+
+GroupRoleRoster::Roster& GroupRoleRoster::GetRoster(Group* group)
+{
+    uint32 now = getMSTime();
+
+    if (getMSTimeDiff(lastPrune, now) >= GROUP_ROSTER_PRUNE_TIME)
+    {
+        lastPrune = now;
+        for (std::unordered_map<ObjectGuid, Roster>::iterator i = rosters.begin(); i != rosters.end();)
+        {
+            if (getMSTimeDiff(i->second.useTime, now) >= GROUP_ROSTER_PRUNE_TIME)
+                i = rosters.erase(i);
+            else
+                ++i;
+        }
+    }
+
+    Roster& roster = rosters[group->GetGUID()];
+    roster.useTime = now;
+
+    if (!roster.buildTime || roster.memberCount != group->GetMembersCount() ||
+        getMSTimeDiff(roster.buildTime, now) >= GROUP_ROSTER_TIME)
+    {
+        Build(group, roster);
+        roster.buildTime = now ? now : 1;
+    }
+
+    return roster;
+}
+
+void GroupRoleRoster::Build(Group* group, Roster& roster)
+{
+    roster.memberCount = group->GetMembersCount();
+    roster.members.clear();
+    roster.healers.clear();
+    roster.rangedDps.clear();
+
+    std::vector<ObjectGuid> otherHealers;
+    std::vector<ObjectGuid> otherRangedDps;
+    std::unordered_map<uint8, int32> classCount;
+
+    GroupRosterMember next;
+    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+    {
+        Player* member = ref->GetSource();
+        if (!member)
+            continue;
+
+        GroupRosterMember rosterMember = next;
+        rosterMember.guid = member->GetGUID();
+        rosterMember.classBefore = classCount[member->getClass()]++;
+        roster.members.push_back(rosterMember);
+
+        bool ranged = PlayerbotAI::IsRanged(member);
+        bool rangedDps = ranged && PlayerbotAI::IsDps(member);
+        bool assistant = group->IsAssistant(member->GetGUID());
+
+        ++next.slot;
+        if (ranged)
+            ++next.rangedBefore;
+        else
+            ++next.meleeBefore;
+
+        if (rangedDps)
+        {
+            ++next.rangedDpsBefore;
+            (assistant ? roster.rangedDps : otherRangedDps).push_back(member->GetGUID());
+        }
+
+        if (PlayerbotAI::IsHeal(member))
+            (assistant ? roster.healers : otherHealers).push_back(member->GetGUID());
+    }
+
+    roster.healers.insert(roster.healers.end(), otherHealers.begin(), otherHealers.end());
+    roster.rangedDps.insert(roster.rangedDps.end(), otherRangedDps.begin(), otherRangedDps.end());
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_GROUPROLEROSTER_H
+#define _PLAYERBOT_GROUPROLEROSTER_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class Group;
+class Player;
+
+#define GROUP_ROSTER_TIME 1000         // ms the roles of a group are reused while its member count is unchanged
+#define GROUP_ROSTER_PRUNE_TIME 60000  // ms without use before the roster of a group is dropped
+
+// Where a member stands among the members before it, in group order
+struct GroupRosterMember
+{
+    ObjectGuid guid;
+    int32 slot = 0;
+    int32 rangedBefore = 0;
+    int32 meleeBefore = 0;
+    int32 rangedDpsBefore = 0;
+    int32 classBefore = 0;
+};
+
+// Roles of the members of every group, for raid strategies asking each bot's position among the
+// ranged, melee or healers of its group several times per update. Real players' spec tabs come from
+// their talents, which are only read again when their talent points or spec change.
+class GroupRoleRoster
+{
+public:
+    GroupRoleRoster(){};
+    virtual ~GroupRoleRoster(){};
+    static GroupRoleRoster* instance()
+    {
+        static GroupRoleRoster instance;
+        return &instance;
+    }
+
+public:
+    uint8 GetSpecTab(Player* player);
+    bool GetMember(Group* group, Player* player, GroupRosterMember& member);
+    // healers and ranged dps of a group, assistants first
+    ObjectGuid GetHealer(Group* group, uint32 index);
+    ObjectGuid GetRangedDps(Group* group, uint32 index);
+
+private:
+    struct SpecTab
+    {
+        uint8 tab;
+        uint8 level;
+        uint8 spec;
+        uint32 talentPoints;
+        uint32 talents;
+    };
+
+    struct Roster
+    {
+        std::vector<GroupRosterMember> members;
+        std::vector<ObjectGuid> healers;
+        std::vector<ObjectGuid> rangedDps;
+        uint32 memberCount = 0;
+        uint32 buildTime = 0;
+        uint32 useTime = 0;
+    };
+
+    Roster& GetRoster(Group* group);
+    void Build(Group* group, Roster& roster);
+
+    std::unordered_map<ObjectGuid, SpecTab> specTabs;
+    std::unordered_map<ObjectGuid, Roster> rosters;
+    uint32 lastPrune = 0;
+    std::mutex specTabsLock;
+    std::mutex rostersLock;
+};
+
+#define sGroupRoleRoster GroupRoleRoster::instance()
+
+#endif
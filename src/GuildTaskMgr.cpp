@@ -523,84 +523,141 @@ uint32 GuildTaskMgr::GetMaxItemTaskCount(uint32 itemId)
     return 1;
 }
 
-bool GuildTaskMgr::IsGuildTaskItem(uint32 itemId, uint32 guildId)
+void GuildTaskMgr::LoadTasks()
 {
-    uint32 value = 0;
+    ClearTasks();
 
-    PlayerbotsDatabasePreparedStatement* stmt =
-        PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_GUILD_TASKS_BY_VALUE);
-    stmt->SetData(0, itemId);
-    stmt->SetData(1, guildId);
-    stmt->SetData(2, "itemTask");
-    if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
+    std::unique_lock<std::shared_mutex> guard(lock);
+
+    // later rows win, as they did when rows were read per value
+    uint32 count = 0;
+    if (QueryResult result = PlayerbotsDatabase.Query(
+            "SELECT owner, guildid, type, `value`, `time`, validIn FROM playerbots_guild_tasks ORDER BY id"))
     {
-        Field* fields = result->Fetch();
-        value = fields[0].Get<uint32>();
-        uint32 lastChangeTime = fields[1].Get<uint32>();
-        uint32 validIn = fields[2].Get<uint32>();
-        if ((time(nullptr) - lastChangeTime) >= validIn)
-            value = 0;
+        do
+        {
+            Field* fields = result->Fetch();
+            GuildTask task;
+            task.value = fields[3].Get<uint32>();
+            task.time = fields[4].Get<uint32>();
+            task.validIn = fields[5].Get<uint32>();
+            StoreTask(fields[0].Get<uint32>(), fields[1].Get<uint32>(), fields[2].Get<std::string>(), task);
+            ++count;
+        } while (result->NextRow());
     }
 
-    return value;
+    LOG_INFO("playerbots", "Loaded {} guild task values for {} owners", count, tasks.size());
 }
 
-std::map<uint32, uint32> GuildTaskMgr::GetTaskValues(uint32 owner, std::string const type,
-                                                     uint32* validIn /* = nullptr */)
+void GuildTaskMgr::ClearTasks()
 {
-    std::map<uint32, uint32> results;
+    std::unique_lock<std::shared_mutex> guard(lock);
+    tasks.clear();
+    itemTasks.clear();
+    killTasks.clear();
+}
 
-    PlayerbotsDatabasePreparedStatement* stmt =
-        PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_GUILD_TASKS_BY_OWNER);
-    stmt->SetData(0, owner);
-    stmt->SetData(1, type);
-    if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
+void GuildTaskMgr::StoreTask(uint32 owner, uint32 guildId, std::string const& type, GuildTask const& task)
+{
+    uint64 key = GetKey(owner, guildId);
+    GuildTaskValues& values = tasks[key];
+
+    uint32 oldValue = 0;
+    GuildTaskValues::iterator i = values.find(type);
+    if (i != values.end())
     {
-        do
-        {
-            Field* fields = result->Fetch();
-            uint32 value = fields[0].Get<uint32>();
-            uint32 lastChangeTime = fields[1].Get<uint32>();
-            uint32 secs = fields[2].Get<uint32>();
-            uint32 guildId = fields[3].Get<uint32>();
-            if ((time(nullptr) - lastChangeTime) >= secs)
-                value = 0;
+        oldValue = i->second.value;
+        values.erase(i);
+    }
 
-            results[guildId] = value;
+    if (task.value)
+        values[type] = task;
 
-        } while (result->NextRow());
+    if (values.empty())
+        tasks.erase(key);
+
+    if (oldValue == task.value)
+        return;
+
+    if (type == "itemTask")
+    {
+        if (oldValue)
+        {
+            std::unordered_map<uint64, std::unordered_set<uint32>>::iterator j =
+                itemTasks.find(GetKey(guildId, oldValue));
+            if (j != itemTasks.end() && j->second.erase(owner) && j->second.empty())
+                itemTasks.erase(j);
+        }
+
+        if (task.value)
+            itemTasks[GetKey(guildId, task.value)].insert(owner);
     }
+    else if (type == "killTask")
+    {
+        if (oldValue)
+        {
+            std::unordered_map<uint64, std::unordered_set<uint32>>::iterator j =
+                killTasks.find(GetKey(owner, oldValue));
+            if (j != killTasks.end() && j->second.erase(guildId) && j->second.empty())
+                killTasks.erase(j);
+        }
 
-    return std::move(results);
+        if (task.value)
+            killTasks[GetKey(owner, task.value)].insert(guildId);
+    }
 }
 
-uint32 GuildTaskMgr::GetTaskValue(uint32 owner, uint32 guildId, std::string const type, uint32* validIn /* = nullptr */)
+bool GuildTaskMgr::IsGuildTaskItem(uint32 itemId, uint32 guildId)
 {
-    uint32 value = 0;
+    std::shared_lock<std::shared_mutex> guard(lock);
+    std::unordered_map<uint64, std::unordered_set<uint32>>::iterator i = itemTasks.find(GetKey(guildId, itemId));
+    if (i == itemTasks.end())
+        return false;
 
-    PlayerbotsDatabasePreparedStatement* stmt =
-        PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_GUILD_TASKS_BY_OWNER_AND_TYPE);
-    stmt->SetData(0, owner);
-    stmt->SetData(1, guildId);
-    stmt->SetData(2, type);
-    if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
+    time_t now = time(nullptr);
+    for (uint32 owner : i->second)
     {
-        Field* fields = result->Fetch();
-        value = fields[0].Get<uint32>();
-        uint32 lastChangeTime = fields[1].Get<uint32>();
-        uint32 secs = fields[2].Get<uint32>();
-        if ((time(nullptr) - lastChangeTime) >= secs)
-            value = 0;
-
-        if (validIn)
-            *validIn = secs;
+        std::unordered_map<uint64, GuildTaskValues>::iterator values = tasks.find(GetKey(owner, guildId));
+        if (values == tasks.end())
+            continue;
+
+        GuildTaskValues::iterator task = values->second.find("itemTask");
+        if (task != values->second.end() && task->second.IsValid(now))
+            return true;
     }
 
-    return value;
+    return false;
+}
+
+uint32 GuildTaskMgr::GetTaskValue(uint32 owner, uint32 guildId, std::string const type, uint32* validIn /* = nullptr */)
+{
+    std::shared_lock<std::shared_mutex> guard(lock);
+    std::unordered_map<uint64, GuildTaskValues>::iterator values = tasks.find(GetKey(owner, guildId));
+    if (values == tasks.end())
+        return 0;
+
+    GuildTaskValues::iterator task = values->second.find(type);
+    if (task == values->second.end())
+        return 0;
+
+    if (validIn)
+        *validIn = task->second.validIn;
+
+    return task->second.IsValid(time(nullptr)) ? task->second.value : 0;
 }
 
 uint32 GuildTaskMgr::SetTaskValue(uint32 owner, uint32 guildId, std::string const type, uint32 value, uint32 validIn)
 {
+    GuildTask task;
+    task.value = value;
+    task.time = time(nullptr);
+    task.validIn = validIn;
+
+    {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        StoreTask(owner, guildId, type, task);
+    }
+
     PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_GUILD_TASKS);
     stmt->SetData(0, owner);
     stmt->SetData(1, guildId);
@@ -612,7 +669,7 @@ uint32 GuildTaskMgr::SetTaskValue(uint32 owner, uint32 guildId, std::string cons
         stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_INS_GUILD_TASKS);
         stmt->SetData(0, owner);
         stmt->SetData(1, guildId);
-        stmt->SetData(2, (uint32)time(nullptr));
+        stmt->SetData(2, task.time);
         stmt->SetData(3, validIn);
         stmt->SetData(4, type);
         stmt->SetData(5, value);
@@ -641,6 +698,8 @@ bool GuildTaskMgr::HandleConsoleCommand(ChatHandler* handler, char const* args)
     if (cmd == "reset")
     {
         PlayerbotsDatabase.Execute("DELETE FROM playerbots_guild_tasks");
+        sGuildTaskMgr->ClearTasks();
+
         LOG_INFO("playerbots", "Guild tasks were reset for all players");
         return true;
     }
@@ -1059,15 +1118,30 @@ void GuildTaskMgr::CheckKillTaskInternal(Player* player, Unit* victim)
     if (!creature)
         return;
 
-    std::map<uint32, uint32> tasks = GetTaskValues(owner, "killTask");
-    for (std::map<uint32, uint32>::iterator i = tasks.begin(); i != tasks.end(); ++i)
+    std::vector<uint32> guilds;
     {
-        uint32 guildId = i->first;
-        uint32 value = i->second;
-        Guild* guild = sGuildMgr->GetGuildById(guildId);
+        std::shared_lock<std::shared_mutex> guard(lock);
+        std::unordered_map<uint64, std::unordered_set<uint32>>::iterator i =
+            killTasks.find(GetKey(owner, creature->GetEntry()));
+        if (i == killTasks.end())
+            return;
+
+        time_t now = time(nullptr);
+        for (uint32 guildId : i->second)
+        {
+            std::unordered_map<uint64, GuildTaskValues>::iterator values = tasks.find(GetKey(owner, guildId));
+            if (values == tasks.end())
+                continue;
 
-        if (value != creature->GetEntry())
-            continue;
+            GuildTaskValues::iterator task = values->second.find("killTask");
+            if (task != values->second.end() && task->second.IsValid(now))
+                guilds.push_back(guildId);
+        }
+    }
+
+    for (uint32 guildId : guilds)
+    {
+        Guild* guild = sGuildMgr->GetGuildById(guildId);
 
         LOG_DEBUG("playerbots", "{} / {}: guild task complete", guild->GetName().c_str(), player->GetName().c_str());
         SetTaskValue(owner, guildId, "reward", 1,
@@ -6,7 +6,11 @@
 #ifndef _PLAYERBOT_GUILDTASKMGR_H
 #define _PLAYERBOT_GUILDTASKMGR_H
 
+#include <ctime>
 #include <map>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "Common.h"
 #include "Transaction.h"
@@ -15,6 +19,19 @@ class ChatHandler;
 class Player;
 class Unit;
 
+// One row of playerbots_guild_tasks
+struct GuildTask
+{
+    uint32 value;
+    uint32 time;
+    uint32 validIn;
+
+    bool IsValid(time_t now) const { return (now - time) < validIn; }
+};
+
+// Task values of one owner in one guild by type
+typedef std::unordered_map<std::string, GuildTask> GuildTaskValues;
+
 class GuildTaskMgr
 {
 public:
@@ -27,6 +44,7 @@ public:
         return &instance;
     }
 
+    void LoadTasks();
     void Update(Player* owner, Player* guildMaster);
 
     static bool HandleConsoleCommand(ChatHandler* handler, char const* args);
@@ -37,7 +55,10 @@ public:
     bool CheckTaskTransfer(std::string const text, Player* owner, Player* bot);
 
 private:
-    std::map<uint32, uint32> GetTaskValues(uint32 owner, std::string const type, uint32* validIn = nullptr);
+    static uint64 GetKey(uint32 first, uint32 second) { return (uint64(first) << 32) | second; }
+
+    void ClearTasks();
+    void StoreTask(uint32 owner, uint32 guildId, std::string const& type, GuildTask const& task);
     uint32 GetTaskValue(uint32 owner, uint32 guildId, std::string const type, uint32* validIn = nullptr);
     uint32 SetTaskValue(uint32 owner, uint32 guildId, std::string const type, uint32 value, uint32 validIn);
     uint32 CreateTask(Player* owner, uint32 guildId);
@@ -55,6 +76,12 @@ private:
     void RemoveDuplicatedAdverts();
     void DeleteMail(std::vector<uint32> buffer);
     void SendCompletionMessage(Player* player, std::string const verb);
+
+    // the table is kept in memory and written through, so item and kill checks never query it
+    std::unordered_map<uint64, GuildTaskValues> tasks;                 // (owner, guild) -> values
+    std::unordered_map<uint64, std::unordered_set<uint32>> itemTasks;  // (guild, item) -> owners
+    std::unordered_map<uint64, std::unordered_set<uint32>> killTasks;  // (owner, creature) -> guilds
+    std::shared_mutex lock;
 };
 
 #define sGuildTaskMgr GuildTaskMgr::instance()
@@ -10,6 +10,8 @@
 #include "Unit.h"
 
 #define MAX_LOOT_OBJECT_COUNT 10
+#define LOOT_SEARCH_REUSE_TIME 1000
+#define LOOT_SEARCH_REUSE_DISTANCE 3.0f
 
 LootTarget::LootTarget(ObjectGuid guid) : guid(guid), asOfTime(time(nullptr)) {}
 
@@ -250,17 +252,19 @@ bool LootObjectStack::Add(ObjectGuid guid)
 {
     if (availableLoot.size() >= MAX_LOOT_OBJECT_COUNT)
     {
-        availableLoot.shrink(time(nullptr) - 30);
+        Shrink();
     }
 
     if (availableLoot.size() >= MAX_LOOT_OBJECT_COUNT)
     {
         availableLoot.clear();
+        ++version;
     }
 
     if (!availableLoot.insert(guid).second)
         return false;
 
+    ++version;
     return true;
 }
 
@@ -268,44 +272,96 @@ void LootObjectStack::Remove(ObjectGuid guid)
 {
     LootTargetList::iterator i = availableLoot.find(guid);
     if (i != availableLoot.end())
+    {
         availableLoot.erase(i);
+        ++version;
+    }
 }
 
-void LootObjectStack::Clear() { availableLoot.clear(); }
+void LootObjectStack::Clear()
+{
+    availableLoot.clear();
+    ++version;
+}
 
 bool LootObjectStack::CanLoot(float maxDistance)
 {
-    std::vector<LootObject> ordered = OrderByDistance(maxDistance);
-    return !ordered.empty();
+    if (IsNearestValid(maxDistance))
+        return !nearest.IsEmpty();
+
+    return !FindNearest(maxDistance).IsEmpty();
 }
 
 LootObject LootObjectStack::GetLoot(float maxDistance)
 {
-    std::vector<LootObject> ordered = OrderByDistance(maxDistance);
-    return ordered.empty() ? LootObject() : *ordered.begin();
+    // the remembered target is checked again as it may have been looted by now
+    if (IsNearestValid(maxDistance))
+    {
+        if (nearest.IsEmpty())
+            return nearest;
+
+        if (nearest.IsLootPossible(bot))
+        {
+            float distance = bot->GetDistance(nearest.GetWorldObject(bot));
+            if (!maxDistance || distance <= maxDistance)
+                return nearest;
+        }
+    }
+
+    return FindNearest(maxDistance);
 }
 
-std::vector<LootObject> LootObjectStack::OrderByDistance(float maxDistance)
+void LootObjectStack::Shrink()
 {
+    size_t size = availableLoot.size();
     availableLoot.shrink(time(nullptr) - 30);
+    if (availableLoot.size() != size)
+        ++version;
+}
+
+bool LootObjectStack::IsNearestValid(float maxDistance)
+{
+    Shrink();
+
+    if (nearestVersion != version || nearestDistance != maxDistance || nearestMapId != bot->GetMapId())
+        return false;
+
+    // corpses and nodes change state without the stack knowing, so a search is only reused for a moment
+    if (getMSTimeDiff(nearestTime, getMSTime()) > LOOT_SEARCH_REUSE_TIME)
+        return false;
+
+    return bot->GetExactDistSq(nearestX, nearestY, nearestZ) <= LOOT_SEARCH_REUSE_DISTANCE * LOOT_SEARCH_REUSE_DISTANCE;
+}
 
-    std::map<float, LootObject> sortedMap;
-    LootTargetList safeCopy(availableLoot);
-    for (LootTargetList::iterator i = safeCopy.begin(); i != safeCopy.end(); i++)
+LootObject LootObjectStack::FindNearest(float maxDistance)
+{
+    nearest = LootObject();
+
+    float nearestLootDistance = 0.0f;
+    for (LootTargetList::iterator i = availableLoot.begin(); i != availableLoot.end(); i++)
     {
-        ObjectGuid guid = i->guid;
-        LootObject lootObject(bot, guid);
+        LootObject lootObject(bot, i->guid);
         if (!lootObject.IsLootPossible(bot))
             continue;
 
         float distance = bot->GetDistance(lootObject.GetWorldObject(bot));
-        if (!maxDistance || distance <= maxDistance)
-            sortedMap[distance] = lootObject;
+        if (maxDistance && distance > maxDistance)
+            continue;
+
+        if (nearest.IsEmpty() || distance < nearestLootDistance)
+        {
+            nearest = lootObject;
+            nearestLootDistance = distance;
+        }
     }
 
-    std::vector<LootObject> result;
-    for (std::map<float, LootObject>::iterator i = sortedMap.begin(); i != sortedMap.end(); i++)
-        result.push_back(i->second);
+    nearestVersion = version;
+    nearestTime = getMSTime();
+    nearestDistance = maxDistance;
+    nearestMapId = bot->GetMapId();
+    nearestX = bot->GetPositionX();
+    nearestY = bot->GetPositionY();
+    nearestZ = bot->GetPositionZ();
 
-    return result;
+    return nearest;
 }
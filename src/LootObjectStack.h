@@ -68,7 +68,11 @@ public:
 class LootObjectStack
 {
 public:
-    LootObjectStack(Player* bot) : bot(bot) {}
+    LootObjectStack(Player* bot)
+        : bot(bot), version(0), nearestVersion(0), nearestTime(0), nearestDistance(-1.0f), nearestMapId(0),
+          nearestX(0.0f), nearestY(0.0f), nearestZ(0.0f)
+    {
+    }
 
     bool Add(ObjectGuid guid);
     void Remove(ObjectGuid guid);
@@ -77,10 +81,21 @@ public:
     LootObject GetLoot(float maxDistance = 0);
 
 private:
-    std::vector<LootObject> OrderByDistance(float maxDistance = 0);
+    bool IsNearestValid(float maxDistance);
+    LootObject FindNearest(float maxDistance);
+    void Shrink();
 
     Player* bot;
     LootTargetList availableLoot;
+    uint32 version;  // changes whenever targets are added or removed
+
+    // nearest lootable target of the last search and where it was searched from
+    LootObject nearest;
+    uint32 nearestVersion;
+    uint32 nearestTime;
+    float nearestDistance;
+    uint32 nearestMapId;
+    float nearestX, nearestY, nearestZ;
 };
 
 #endif
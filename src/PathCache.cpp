@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PathCache.h"
+
+#include <cmath>
+
+#include "Timer.h"
+#include "Unit.h"
+
+PathCacheKey::PathCacheKey(Unit* unit, float x, float y, float z, PathCacheSearch search, uint32 params)
+    : instanceId(unit->GetInstanceId()),
+      startX(int32(std::floor(unit->GetPositionX() / PATH_CACHE_CELL_SIZE))),
+      startY(int32(std::floor(unit->GetPositionY() / PATH_CACHE_CELL_SIZE))),
+      startZ(int32(std::floor(unit->GetPositionZ() / PATH_CACHE_HEIGHT_BAND))),
+      endX(int32(std::floor(x / PATH_CACHE_CELL_SIZE))),
+      endY(int32(std::floor(y / PATH_CACHE_CELL_SIZE))),
+      endZ(int32(std::floor(z / PATH_CACHE_HEIGHT_BAND))),
+      collisionHeight(uint32(unit->GetCollisionHeight() * 10.0f)),
+      search(search),
+      params(params)
+{
+}
+
+bool PathCacheKey::operator==(PathCacheKey const& other) const
+{
+    return instanceId == other.instanceId && startX == other.startX && startY == other.startY &&
+           startZ == other.startZ && endX == other.endX && endY == other.endY && endZ == other.endZ &&
+           collisionHeight == other.collisionHeight && search == other.search && params == other.params;
+}
+
+size_t PathCacheKeyHash::operator()(PathCacheKey const& key) const
+{
+    size_t hash = key.instanceId;
+    for (uint32 value : {uint32(key.startX), uint32(key.startY), uint32(key.startZ), uint32(key.endX),
+                         uint32(key.endY), uint32(key.endZ), key.collisionHeight, key.search, key.params})
+        hash = hash * 31 + value;
+
+    return hash;
+}
+
+bool PathCache::IsCacheable(Unit* unit)
+{
+    // paths on transports are relative to the transport, which keeps moving
+    return unit->IsInWorld() && !unit->GetTransport();
+}
+
+PathCache::MapPaths* PathCache::GetMapPaths(uint32 mapId)
+{
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        std::unordered_map<uint32, std::unique_ptr<MapPaths>>::iterator i = maps.find(mapId);
+        if (i != maps.end())
+            return i->second.get();
+    }
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+    std::unique_ptr<MapPaths>& paths = maps[mapId];
+    if (!paths)
+        paths = std::make_unique<MapPaths>();
+
+    return paths.get();
+}
+
+bool PathCache::Find(uint32 mapId, PathCacheKey const& key, PathCacheEntry& entry)
+{
+    MapPaths* mapPaths = GetMapPaths(mapId);
+
+    std::lock_guard<std::mutex> guard(mapPaths->lock);
+    std::unordered_map<PathCacheKey, PathCacheEntry, PathCacheKeyHash>::iterator i = mapPaths->paths.find(key);
+    if (i == mapPaths->paths.end() || getMSTimeDiff(i->second.time, getMSTime()) >= PATH_CACHE_TIME)
+    {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    hits.fetch_add(1, std::memory_order_relaxed);
+    entry = i->second;
+    return true;
+}
+
+void PathCache::Store(uint32 mapId, PathCacheKey const& key, PathCacheEntry const& entry)
+{
+    MapPaths* mapPaths = GetMapPaths(mapId);
+
+    std::lock_guard<std::mutex> guard(mapPaths->lock);
+    if (mapPaths->paths.size() >= PATH_CACHE_MAX_ENTRIES)
+    {
+        uint32 now = getMSTime();
+        for (std::unordered_map<PathCacheKey, PathCacheEntry, PathCacheKeyHash>::iterator i = mapPaths->paths.begin();
+             i != mapPaths->paths.end();)
+        {
+            if (getMSTimeDiff(i->second.time, now) >= PATH_CACHE_TIME)
+                i = mapPaths->paths.erase(i);
+            else
+                ++i;
+        }
+
+        if (mapPaths->paths.size() >= PATH_CACHE_MAX_ENTRIES)
+            mapPaths->paths.clear();
+    }
+
+    mapPaths->paths[key] = entry;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PATHCACHE_H
+#define _PLAYERBOT_PATHCACHE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "Common.h"
+#include "PathGenerator.h"
+
+class Unit;
+
+#define PATH_CACHE_TIME 2000          // ms a path is reused
+#define PATH_CACHE_CELL_SIZE 1.0f     // start and end positions within one cell share a path
+#define PATH_CACHE_HEIGHT_BAND 2.0f
+#define PATH_CACHE_MAX_ENTRIES 4096  // per map
+
+enum PathCacheSearch
+{
+    PATH_CACHE_BEST_PATH,  // MovementAction::SearchForBestPath
+    PATH_CACHE_LOS_PATH    // MovementAction::MoveToLOS
+};
+
+struct PathCacheKey
+{
+    PathCacheKey(Unit* unit, float x, float y, float z, PathCacheSearch search, uint32 params = 0);
+
+    bool operator==(PathCacheKey const& other) const;
+
+    uint32 instanceId;
+    int32 startX, startY, startZ;
+    int32 endX, endY, endZ;
+    uint32 collisionHeight;
+    uint32 search;
+    uint32 params;
+};
+
+struct PathCacheKeyHash
+{
+    size_t operator()(PathCacheKey const& key) const;
+};
+
+struct PathCacheEntry
+{
+    Movement::PointsArray path;
+    PathType type;
+    float z;  // destination height the path leads to
+    uint32 time;
+};
+
+// Path search results shared by all bots on a map. Bots chasing or following the same target search
+// nearly the same paths every few updates, so a result is reused for a short time by any bot whose start
+// and destination fall into the same cells. Only successful searches are stored, and callers end a reused
+// path at their own destination.
+class PathCache
+{
+public:
+    PathCache(){};
+    virtual ~PathCache(){};
+    static PathCache* instance()
+    {
+        static PathCache instance;
+        return &instance;
+    }
+
+public:
+    static bool IsCacheable(Unit* unit);
+    bool Find(uint32 mapId, PathCacheKey const& key, PathCacheEntry& entry);
+    void Store(uint32 mapId, PathCacheKey const& key, PathCacheEntry const& entry);
+
+    std::atomic<uint64> hits{0};
+    std::atomic<uint64> misses{0};
+
+private:
+    struct MapPaths
+    {
+        std::unordered_map<PathCacheKey, PathCacheEntry, PathCacheKeyHash> paths;
+        std::mutex lock;
+    };
+
+    MapPaths* GetMapPaths(uint32 mapId);
+
+    std::unordered_map<uint32, std::unique_ptr<MapPaths>> maps;
+    std::shared_mutex lock;
+};
+
+#define sPathCache PathCache::instance()
+
+#endif
@@ -5,60 +5,295 @@
 
 #include "PerformanceMonitor.h"
 
+#include "Config.h"
+#include "NamedObjectRegistry.h"
 #include "Playerbots.h"
 
-PerformanceMonitorOperation* PerformanceMonitor::start(PerformanceMetric metric, std::string const name,
+namespace
+{
+    struct MetricKeyHash
+    {
+        size_t operator()(std::tuple<uint32, uint32, uint32> const& key) const
+        {
+            return (size_t(std::get<0>(key)) * 31 + std::get<1>(key)) * 1000003 + std::get<2>(key);
+        }
+    };
+
+    // per thread caches, so the hot path never touches the shared key table or its mutex
+    struct PerformanceThreadData
+    {
+        PerformanceShard* shard = nullptr;
+        PerformanceMonitorOperation* freeOperations = nullptr;
+        std::unordered_map<std::string, uint32> nameIds;
+        std::unordered_map<std::tuple<uint32, uint32, uint32>, uint32, MetricKeyHash> keys;
+    };
+
+    thread_local PerformanceThreadData threadData;
+
+    uint32 GetBucket(uint64 elapsed)
+    {
+        if (elapsed < 2)
+            return elapsed;
+
+        // two buckets per power of two
+        uint32 msb = 1;
+        while (elapsed >> (msb + 1))
+            ++msb;
+
+        uint32 bucket = msb * 2 + ((elapsed >> (msb - 1)) & 1);
+        return std::min<uint32>(bucket, PERF_MON_BUCKETS - 1);
+    }
+
+    uint64 GetBucketLimit(uint32 bucket)
+    {
+        if (bucket < 2)
+            return bucket;
+
+        uint32 msb = bucket / 2;
+        uint64 half = uint64(1) << (msb - 1);
+        return (uint64(1) << msb) + (bucket % 2) * half + half - 1;
+    }
+}  // namespace
+
+uint64 PerformanceData::Percentile(float fraction) const
+{
+    if (!count)
+        return 0;
+
+    uint64 rank = std::max<uint64>(1, uint64(fraction * count + 0.5f));
+    uint64 seen = 0;
+    for (uint32 i = 0; i < PERF_MON_BUCKETS; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min(GetBucketLimit(i), maxTime);
+    }
+
+    return maxTime;
+}
+
+PerformanceShard::PerformanceShard() : size(0), epoch(0)
+{
+    for (uint32 i = 0; i < PERF_MON_MAX_BLOCKS; ++i)
+        blocks[i].store(nullptr, std::memory_order_relaxed);
+}
+
+PerformanceCounter* PerformanceShard::GetCounter(uint32 key)
+{
+    std::unordered_map<uint32, PerformanceCounter*>::iterator found = index.find(key);
+    if (found != index.end())
+        return found->second;
+
+    uint32 slot = size.load(std::memory_order_relaxed);
+    uint32 block = slot / PERF_MON_BLOCK_SIZE;
+    if (block >= PERF_MON_MAX_BLOCKS)
+        return nullptr;
+
+    PerformanceCounter* counters = blocks[block].load(std::memory_order_relaxed);
+    if (!counters)
+    {
+        counters = new PerformanceCounter[PERF_MON_BLOCK_SIZE];
+        for (uint32 i = 0; i < PERF_MON_BLOCK_SIZE; ++i)
+        {
+            PerformanceCounter& counter = counters[i];
+            counter.key.store(0, std::memory_order_relaxed);
+            counter.minTime.store(0, std::memory_order_relaxed);
+            counter.maxTime.store(0, std::memory_order_relaxed);
+            counter.totalTime.store(0, std::memory_order_relaxed);
+            counter.count.store(0, std::memory_order_relaxed);
+            for (uint32 j = 0; j < PERF_MON_BUCKETS; ++j)
+                counter.buckets[j].store(0, std::memory_order_relaxed);
+        }
+
+        blocks[block].store(counters, std::memory_order_release);
+    }
+
+    PerformanceCounter* counter = &counters[slot % PERF_MON_BLOCK_SIZE];
+    counter->key.store(key, std::memory_order_relaxed);
+    size.store(slot + 1, std::memory_order_release);
+
+    index[key] = counter;
+    return counter;
+}
+
+void PerformanceShard::Clear()
+{
+    // keys keep their slots, only the samples are dropped
+    uint32 count = size.load(std::memory_order_relaxed);
+    for (uint32 slot = 0; slot < count; ++slot)
+    {
+        PerformanceCounter& counter = blocks[slot / PERF_MON_BLOCK_SIZE].load(
+            std::memory_order_relaxed)[slot % PERF_MON_BLOCK_SIZE];
+        counter.minTime.store(0, std::memory_order_relaxed);
+        counter.maxTime.store(0, std::memory_order_relaxed);
+        counter.totalTime.store(0, std::memory_order_relaxed);
+        counter.count.store(0, std::memory_order_relaxed);
+        for (uint32 k = 0; k < PERF_MON_BUCKETS; ++k)
+            counter.buckets[k].store(0, std::memory_order_relaxed);
+    }
+}
+
+PerformanceMonitorOperation* PerformanceMonitor::start(PerformanceMetric metric, std::string const& name,
                                                        PerformanceStack* stack)
 {
     if (!sPlayerbotAIConfig->perfMonEnabled)
         return nullptr;
 
-    std::string stackName = name;
+    uint32 key = GetKey(metric, name, stack && !stack->empty() ? stack->back() : 0);
+
+    PerformanceMonitorOperation* operation = threadData.freeOperations;
+    if (operation)
+        threadData.freeOperations = operation->next;
+    else
+        operation = new PerformanceMonitorOperation();
+
+    operation->key = key;
+    operation->stack = stack;
+    operation->next = nullptr;
 
     if (stack)
+        stack->push_back(key);
+
+    operation->started = std::chrono::steady_clock::now();
+    return operation;
+}
+
+uint32 PerformanceMonitor::GetKey(PerformanceMetric metric, std::string const& name, uint32 parent)
+{
+    std::unordered_map<std::string, uint32>::iterator nameId = threadData.nameIds.find(name);
+    if (nameId == threadData.nameIds.end())
+        nameId = threadData.nameIds.emplace(name, sNamedObjectRegistry->Intern(name)).first;
+
+    std::tuple<uint32, uint32, uint32> tuple(metric, nameId->second, parent);
+    auto cached = threadData.keys.find(tuple);
+    if (cached != threadData.keys.end())
+        return cached->second;
+
+    std::lock_guard<std::mutex> guard(lock);
+    uint32& key = keyIndex[tuple];
+    if (!key)
     {
-        if (!stack->empty())
-        {
-            std::ostringstream out;
-            out << stackName << " [";
+        keys.push_back(MetricKey{metric, nameId->second, parent});
+        key = keys.size();
+    }
 
-            for (std::vector<std::string>::reverse_iterator i = stack->rbegin(); i != stack->rend(); ++i)
-                out << *i << (std::next(i) == stack->rend() ? "" : "|");
+    threadData.keys[tuple] = key;
+    return key;
+}
 
-            out << "]";
+PerformanceShard* PerformanceMonitor::GetShard()
+{
+    PerformanceShard* shard = threadData.shard;
+    if (!shard)
+    {
+        shard = new PerformanceShard();
+        shard->epoch.store(epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
 
-            stackName = out.str().c_str();
-        }
+        std::lock_guard<std::mutex> guard(lock);
+        shards.push_back(shard);
+        threadData.shard = shard;
+    }
 
-        stack->push_back(name);
+    // Reset only bumps the epoch, every thread clears its own shard before the next sample
+    uint32 current = epoch.load(std::memory_order_acquire);
+    if (shard->epoch.load(std::memory_order_relaxed) != current)
+    {
+        shard->Clear();
+        shard->epoch.store(current, std::memory_order_release);
     }
 
-    std::lock_guard<std::mutex> guard(lock);
-    PerformanceData* pd = data[metric][stackName];
-    if (!pd)
+    return shard;
+}
+
+std::map<PerformanceMetric, std::map<std::string, PerformanceData>> PerformanceMonitor::Merge()
+{
+    std::map<PerformanceMetric, std::map<std::string, PerformanceData>> result;
+
+    std::vector<MetricKey> keyList;
+    std::vector<PerformanceShard*> shardList;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        keyList = keys;
+        shardList = shards;
+    }
+
+    std::vector<PerformanceData> merged(keyList.size() + 1);
+    uint32 current = epoch.load(std::memory_order_acquire);
+    for (PerformanceShard* shard : shardList)
     {
-        pd = new PerformanceData();
-        pd->minTime = 0;
-        pd->maxTime = 0;
-        pd->totalTime = 0;
-        pd->count = 0;
-        data[metric][stackName] = pd;
+        if (shard->epoch.load(std::memory_order_acquire) != current)
+            continue;
+
+        uint32 size = shard->size.load(std::memory_order_acquire);
+        for (uint32 slot = 0; slot < size; ++slot)
+        {
+            PerformanceCounter& counter =
+                shard->blocks[slot / PERF_MON_BLOCK_SIZE].load(std::memory_order_acquire)[slot % PERF_MON_BLOCK_SIZE];
+
+            // keys registered after the key list was copied are left for the next merge
+            uint32 key = counter.key.load(std::memory_order_relaxed);
+            if (!key || key > keyList.size())
+                continue;
+
+            uint32 count = counter.count.load(std::memory_order_relaxed);
+            if (!count)
+                continue;
+
+            PerformanceData& pd = merged[key];
+            uint64 minTime = counter.minTime.load(std::memory_order_relaxed);
+            uint64 maxTime = counter.maxTime.load(std::memory_order_relaxed);
+            if (minTime && (!pd.minTime || pd.minTime > minTime))
+                pd.minTime = minTime;
+
+            if (pd.maxTime < maxTime)
+                pd.maxTime = maxTime;
+
+            pd.totalTime += counter.totalTime.load(std::memory_order_relaxed);
+            pd.count += count;
+            for (uint32 i = 0; i < PERF_MON_BUCKETS; ++i)
+                pd.buckets[i] += counter.buckets[i].load(std::memory_order_relaxed);
+        }
     }
 
-    return new PerformanceMonitorOperation(pd, name, stack);
+    for (uint32 key = 1; key <= keyList.size(); ++key)
+    {
+        if (!merged[key].count)
+            continue;
+
+        MetricKey const& metricKey = keyList[key - 1];
+        std::string name = sNamedObjectRegistry->GetName(metricKey.nameId);
+        if (metricKey.parent)
+        {
+            name += " [";
+            for (uint32 parent = metricKey.parent; parent; parent = keyList[parent - 1].parent)
+                name += sNamedObjectRegistry->GetName(keyList[parent - 1].nameId) +
+                        (keyList[parent - 1].parent ? "|" : "");
+
+            name += "]";
+        }
+
+        result[metricKey.metric][name] = merged[key];
+    }
+
+    return result;
 }
 
 void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
 {
+    std::map<PerformanceMetric, std::map<std::string, PerformanceData>> data = Merge();
     if (data.empty())
         return;
 
+    if (uint64 dropped = droppedSamples.load(std::memory_order_relaxed))
+        LOG_WARN("playerbots", "Performance monitor dropped {} samples, a thread sampled more than {} distinct keys",
+                 dropped, PERF_MON_MAX_BLOCKS * PERF_MON_BLOCK_SIZE);
+
     if (!perTick)
     {
         float updateAITotalTime = 0;
         for (auto& map : data[PERF_MON_TOTAL])
             if (map.first.find("PlayerbotAI::UpdateAIInternal") != std::string::npos)
-                updateAITotalTime += map.second->totalTime;
+                updateAITotalTime += map.second.totalTime;
 
         LOG_INFO(
             "playerbots",
@@ -69,10 +304,10 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
             "playerbots",
             "-------------------------------------------------------------------------------------------------------");
 
-        for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
+        for (std::map<PerformanceMetric, std::map<std::string, PerformanceData>>::iterator i = data.begin();
              i != data.end(); ++i)
         {
-            std::map<std::string, PerformanceData*> pdMap = i->second;
+            std::map<std::string, PerformanceData>& pdMap = i->second;
 
             std::string key;
             switch (i->first)
@@ -99,7 +334,7 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
 
             std::vector<std::string> names;
 
-            for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
+            for (std::map<std::string, PerformanceData>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
             {
                 if (key == "Total" && j->first.find("PlayerbotAI::UpdateAIInternal") == std::string::npos)
                     continue;
@@ -108,8 +343,8 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
             }
 
             std::sort(names.begin(), names.end(),
-                      [pdMap](std::string const i, std::string const j)
-                      { return pdMap.at(i)->totalTime < pdMap.at(j)->totalTime; });
+                      [&pdMap](std::string const& i, std::string const& j)
+                      { return pdMap.at(i).totalTime < pdMap.at(j).totalTime; });
 
             uint64 typeTotalTime = 0;
             uint64 typeMinTime = 0xffffffffu;
@@ -117,7 +352,7 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
             uint32 typeCount = 0;
             for (auto& name : names)
             {
-                PerformanceData* pd = pdMap[name];
+                PerformanceData* pd = &pdMap[name];
                 typeTotalTime += pd->totalTime;
                 typeCount += pd->count;
                 if (typeMinTime > pd->minTime)
@@ -152,8 +387,13 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
     }
     else
     {
-        float fullTickCount = data[PERF_MON_TOTAL]["RandomPlayerbotMgr::FullTick"]->count;
-        float fullTickTotalTime = data[PERF_MON_TOTAL]["RandomPlayerbotMgr::FullTick"]->totalTime;
+        std::map<std::string, PerformanceData>::iterator fullTick =
+            data[PERF_MON_TOTAL].find("RandomPlayerbotMgr::FullTick");
+        if (fullTick == data[PERF_MON_TOTAL].end() || !fullTick->second.count)
+            return;
+
+        float fullTickCount = fullTick->second.count;
+        float fullTickTotalTime = fullTick->second.totalTime;
 
         LOG_INFO(
             "playerbots",
@@ -164,10 +404,10 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
             "playerbots",
             "-------------------------------------------------------------------------------------------------------");
 
-        for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
+        for (std::map<PerformanceMetric, std::map<std::string, PerformanceData>>::iterator i = data.begin();
              i != data.end(); ++i)
         {
-            std::map<std::string, PerformanceData*> pdMap = i->second;
+            std::map<std::string, PerformanceData>& pdMap = i->second;
 
             std::string key;
             switch (i->first)
@@ -193,14 +433,14 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
 
             std::vector<std::string> names;
 
-            for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
+            for (std::map<std::string, PerformanceData>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
             {
                 names.push_back(j->first);
             }
 
             std::sort(names.begin(), names.end(),
-                      [pdMap](std::string const i, std::string const j)
-                      { return pdMap.at(i)->totalTime < pdMap.at(j)->totalTime; });
+                      [&pdMap](std::string const& i, std::string const& j)
+                      { return pdMap.at(i).totalTime < pdMap.at(j).totalTime; });
 
             uint64 typeTotalTime = 0;
             uint64 typeMinTime = 0xffffffffu;
@@ -208,7 +448,7 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
             uint32 typeCount = 0;
             for (auto& name : names)
             {
-                PerformanceData* pd = pdMap[name];
+                PerformanceData* pd = &pdMap[name];
                 typeTotalTime += pd->totalTime;
                 typeCount += pd->count;
                 if (typeMinTime > pd->minTime)
@@ -247,57 +487,124 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
     }
 }
 
-void PerformanceMonitor::Reset()
+bool PerformanceMonitor::Dump(std::string const fileName)
 {
-    for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
+    std::map<PerformanceMetric, std::map<std::string, PerformanceData>> data = Merge();
+
+    std::string logsDir = sConfigMgr->GetOption<std::string>("LogsDir", "", false);
+    if (!logsDir.empty() && logsDir.back() != '/' && logsDir.back() != '\\')
+        logsDir.append("/");
+
+    FILE* file = fopen((logsDir + fileName).c_str(), "w");
+    if (!file)
+    {
+        LOG_ERROR("playerbots", "Could not write performance monitor dump {}", logsDir + fileName);
+        return false;
+    }
+
+    fprintf(file, "metric,name,count,total_us,min_us,max_us,avg_us,p50_us,p99_us\n");
+    for (std::map<PerformanceMetric, std::map<std::string, PerformanceData>>::iterator i = data.begin();
          i != data.end(); ++i)
     {
-        std::map<std::string, PerformanceData*> pdMap = i->second;
-        for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
+        for (std::map<std::string, PerformanceData>::iterator j = i->second.begin(); j != i->second.end(); ++j)
         {
-            PerformanceData* pd = j->second;
-            std::lock_guard<std::mutex> guard(pd->lock);
-            pd->minTime = 0;
-            pd->maxTime = 0;
-            pd->totalTime = 0;
-            pd->count = 0;
+            PerformanceData const& pd = j->second;
+
+            std::string name = j->first;
+            for (size_t pos = name.find('"'); pos != std::string::npos; pos = name.find('"', pos + 2))
+                name.insert(pos, "\"");
+
+            fprintf(file, "%u,\"%s\",%u,%llu,%llu,%llu,%.1f,%llu,%llu\n", uint32(i->first), name.c_str(), pd.count,
+                    (unsigned long long)pd.totalTime, (unsigned long long)pd.minTime,
+                    (unsigned long long)pd.maxTime, (double)pd.totalTime / pd.count,
+                    (unsigned long long)pd.Percentile(0.5f), (unsigned long long)pd.Percentile(0.99f));
         }
     }
+
+    // samples that found no free counter are not part of any row above
+    fprintf(file, "%u,\"%s\",%llu,0,0,0,0.0,0,0\n", uint32(PERF_MON_TOTAL), "PerformanceMonitor::DroppedSamples",
+            (unsigned long long)droppedSamples.load(std::memory_order_relaxed));
+
+    fclose(file);
+    return true;
 }
 
-PerformanceMonitorOperation::PerformanceMonitorOperation(PerformanceData* data, std::string const name,
-                                                         PerformanceStack* stack)
-    : data(data), name(name), stack(stack)
+bool PerformanceMonitor::DumpAsync(std::string const fileName)
 {
-    started = (std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()))
-                  .time_since_epoch();
+    // merging and writing happen on a helper thread, the world thread only checks the previous dump finished
+    if (pendingDump.valid() && pendingDump.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+
+    pendingDump = std::async(std::launch::async, &PerformanceMonitor::Dump, this, fileName);
+    return true;
+}
+
+void PerformanceMonitor::Update()
+{
+    if (!sPlayerbotAIConfig->perfMonEnabled || !sPlayerbotAIConfig->perfMonDumpInterval)
+        return;
+
+    time_t now = time(nullptr);
+    if (now - lastDump < sPlayerbotAIConfig->perfMonDumpInterval)
+        return;
+
+    lastDump = now;
+    DumpAsync("perfmon.csv");
+}
+
+void PerformanceMonitor::Reset()
+{
+    droppedSamples.store(0, std::memory_order_relaxed);
+    epoch.fetch_add(1, std::memory_order_acq_rel);
 }
 
 void PerformanceMonitorOperation::finish()
 {
-    std::chrono::microseconds finished =
-        (std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()))
-            .time_since_epoch();
-    uint64_t elapsed = (finished - started).count();
+    uint64 elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count();
 
-    std::lock_guard<std::mutex> guard(data->lock);
-    if (elapsed > 0)
+    if (PerformanceCounter* data = sPerformanceMonitor->GetShard()->GetCounter(key))
     {
-        if (!data->minTime || data->minTime > elapsed)
-            data->minTime = elapsed;
+        if (elapsed > 0)
+        {
+            uint64 minTime = data->minTime.load(std::memory_order_relaxed);
+            if (!minTime || minTime > elapsed)
+                data->minTime.store(elapsed, std::memory_order_relaxed);
 
-        if (!data->maxTime || data->maxTime < elapsed)
-            data->maxTime = elapsed;
+            if (data->maxTime.load(std::memory_order_relaxed) < elapsed)
+                data->maxTime.store(elapsed, std::memory_order_relaxed);
 
-        data->totalTime += elapsed;
-    }
+            data->totalTime.store(data->totalTime.load(std::memory_order_relaxed) + elapsed,
+                                  std::memory_order_relaxed);
+        }
 
-    ++data->count;
+        std::atomic<uint64>& bucket = data->buckets[GetBucket(elapsed)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        data->count.store(data->count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    else
+        sPerformanceMonitor->droppedSamples.fetch_add(1, std::memory_order_relaxed);
 
     if (stack)
     {
-        stack->erase(std::remove(stack->begin(), stack->end(), name), stack->end());
+        if (!stack->empty() && stack->back() == key)
+            stack->pop_back();
+        else
+            stack->erase(std::remove(stack->begin(), stack->end(), key), stack->end());
     }
 
-    delete this;
+    next = threadData.freeOperations;
+    threadData.freeOperations = this;
+}
+
+PerformanceMonitorScope::PerformanceMonitorScope(PerformanceMetric metric, std::string const& name,
+                                                 PerformanceStack* stack)
+    : operation(sPerformanceMonitor->start(metric, name, stack))
+{
+}
+
+PerformanceMonitorScope::~PerformanceMonitorScope()
+{
+    if (operation)
+        operation->finish();
 }
@@ -6,23 +6,34 @@
 #ifndef _PLAYERBOT_PERFORMANCEMONITOR_H
 #define _PLAYERBOT_PERFORMANCEMONITOR_H
 
+#include <atomic>
 #include <chrono>
 #include <ctime>
+#include <future>
 #include <map>
 #include <mutex>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "Common.h"
 
-typedef std::vector<std::string> PerformanceStack;
+#define PERF_MON_BUCKETS 64
+#define PERF_MON_BLOCK_SIZE 64
+#define PERF_MON_MAX_BLOCKS 1024  // distinct keys one thread can sample: blocks * block size
+
+// metric keys of the operations currently open on a bot, innermost last
+typedef std::vector<uint32> PerformanceStack;
 
 struct PerformanceData
 {
-    uint64 minTime;
-    uint64 maxTime;
-    uint64 totalTime;
-    uint32 count;
-    std::mutex lock;
+    uint64 minTime = 0;
+    uint64 maxTime = 0;
+    uint64 totalTime = 0;
+    uint32 count = 0;
+    uint64 buckets[PERF_MON_BUCKETS] = {};
+
+    uint64 Percentile(float fraction) const;
 };
 
 enum PerformanceMetric
@@ -34,23 +45,62 @@ enum PerformanceMetric
     PERF_MON_TOTAL
 };
 
+// Counters of one metric key in one thread shard. Only the owning thread writes them,
+// so plain load/store is enough and readers merging the shards never take a lock.
+struct PerformanceCounter
+{
+    std::atomic<uint32> key;
+    std::atomic<uint64> minTime;
+    std::atomic<uint64> maxTime;
+    std::atomic<uint64> totalTime;
+    std::atomic<uint32> count;
+    std::atomic<uint64> buckets[PERF_MON_BUCKETS];
+};
+
+// Counters of the keys one thread has sampled, in the order it first met them. Blocks are allocated
+// as new keys show up, so a shard only grows with the operations its thread actually runs.
+struct PerformanceShard
+{
+    PerformanceShard();
+
+    PerformanceCounter* GetCounter(uint32 key);
+    void Clear();
+
+    std::atomic<PerformanceCounter*> blocks[PERF_MON_MAX_BLOCKS];
+    std::atomic<uint32> size;  // counters published to readers
+    std::atomic<uint32> epoch;
+    std::unordered_map<uint32, PerformanceCounter*> index;  // key -> counter, owning thread only
+};
+
 class PerformanceMonitorOperation
 {
 public:
-    PerformanceMonitorOperation(PerformanceData* data, std::string const name, PerformanceStack* stack);
     void finish();
 
 private:
-    PerformanceData* data;
-    std::string const name;
+    friend class PerformanceMonitor;
+
+    uint32 key;
     PerformanceStack* stack;
-    std::chrono::microseconds started;
+    std::chrono::steady_clock::time_point started;
+    PerformanceMonitorOperation* next;
+};
+
+// Finishes the operation when leaving scope
+class PerformanceMonitorScope
+{
+public:
+    PerformanceMonitorScope(PerformanceMetric metric, std::string const& name, PerformanceStack* stack = nullptr);
+    ~PerformanceMonitorScope();
+
+private:
+    PerformanceMonitorOperation* operation;
 };
 
 class PerformanceMonitor
 {
 public:
-    PerformanceMonitor(){};
+    PerformanceMonitor() : epoch(0), droppedSamples(0), lastDump(0){};
     virtual ~PerformanceMonitor(){};
     static PerformanceMonitor* instance()
     {
@@ -59,13 +109,35 @@ public:
     }
 
 public:
-    PerformanceMonitorOperation* start(PerformanceMetric metric, std::string const name,
+    PerformanceMonitorOperation* start(PerformanceMetric metric, std::string const& name,
                                        PerformanceStack* stack = nullptr);
     void PrintStats(bool perTick = false, bool fullStack = false);
+    bool Dump(std::string const fileName);
+    bool DumpAsync(std::string const fileName);
+    void Update();
     void Reset();
 
 private:
-    std::map<PerformanceMetric, std::map<std::string, PerformanceData*> > data;
+    friend class PerformanceMonitorOperation;
+
+    struct MetricKey
+    {
+        PerformanceMetric metric;
+        uint32 nameId;
+        uint32 parent;
+    };
+
+    uint32 GetKey(PerformanceMetric metric, std::string const& name, uint32 parent);
+    PerformanceShard* GetShard();
+    std::map<PerformanceMetric, std::map<std::string, PerformanceData>> Merge();
+
+    std::vector<MetricKey> keys;  // key - 1 -> metric, 0 is no key
+    std::map<std::tuple<uint32, uint32, uint32>, uint32> keyIndex;
+    std::vector<PerformanceShard*> shards;
+    std::atomic<uint32> epoch;
+    std::atomic<uint64> droppedSamples;  // samples of threads whose shard ran out of counters
+    time_t lastDump;
+    std::future<bool> pendingDump;
     std::mutex lock;
 };
 
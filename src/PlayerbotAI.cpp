@@ -17,6 +17,7 @@
 #include "Engine.h"
 #include "ExternalEventHelper.h"
 #include "GuildMgr.h"
+#include "GroupRoleRoster.h"
 #include "GuildTaskMgr.h"
 #include "LFGMgr.h"
 #include "LastMovementValue.h"
@@ -36,12 +37,14 @@
 #include "Playerbots.h"
 #include "PointMovementGenerator.h"
 #include "PositionValue.h"
+#include "RealPlayerGrid.h"
 #include "SayAction.h"
 #include "ScriptMgr.h"
 #include "ServerFacade.h"
 #include "SharedDefines.h"
 #include "SocialMgr.h"
 #include "SpellAuraEffects.h"
+#include "SpellNameIndex.h"
 #include "Unit.h"
 #include "UpdateTime.h"
 #include "Vehicle.h"
@@ -51,6 +54,9 @@ std::vector<std::string> PlayerbotAI::dispel_whitelist = {
     "frostbolt",
 };
 
+std::atomic<uint64> PlayerbotAI::castChecks(0);
+std::atomic<uint64> PlayerbotAI::castChecksCached(0);
+
 std::vector<std::string>& split(std::string const s, char delim, std::vector<std::string>& elems);
 std::vector<std::string> split(std::string const s, char delim);
 char* strstri(char const* str1, char const* str2);
@@ -1407,7 +1413,7 @@ bool PlayerbotAI::IsRanged(Player* player)
     if (botAi)
         return botAi->ContainsStrategy(STRATEGY_TYPE_RANGED);
 
-    int tab = AiFactory::GetPlayerSpecTab(player);
+    int tab = sGroupRoleRoster->GetSpecTab(player);
     switch (player->getClass())
     {
         case CLASS_DEATH_KNIGHT:
@@ -1453,75 +1459,23 @@ bool PlayerbotAI::IsRangedDps(Player* player) { return IsRanged(player) && IsDps
 bool PlayerbotAI::IsHealAssistantOfIndex(Player* player, int index)
 {
     Group* group = bot->GetGroup();
-    if (!group)
+    if (!group || index < 0)
     {
         return false;
     }
-    Group::MemberSlotList const& slots = group->GetMemberSlots();
-    int counter = 0;
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
-    {
-        Player* member = ref->GetSource();
-        if (group->IsAssistant(member->GetGUID()) && IsHeal(member))
-        {
-            if (index == counter)
-            {
-                return player == member;
-            }
-            counter++;
-        }
-    }
-    // not enough
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
-    {
-        Player* member = ref->GetSource();
-        if (!group->IsAssistant(member->GetGUID()) && IsHeal(member))
-        {
-            if (index == counter)
-            {
-                return player == member;
-            }
-            counter++;
-        }
-    }
-    return false;
+    ObjectGuid healer = sGroupRoleRoster->GetHealer(group, index);
+    return !healer.IsEmpty() && healer == player->GetGUID();
 }
 
 bool PlayerbotAI::IsRangedDpsAssistantOfIndex(Player* player, int index)
 {
     Group* group = bot->GetGroup();
-    if (!group)
+    if (!group || index < 0)
     {
         return false;
     }
-    Group::MemberSlotList const& slots = group->GetMemberSlots();
-    int counter = 0;
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
-    {
-        Player* member = ref->GetSource();
-        if (group->IsAssistant(member->GetGUID()) && IsRangedDps(member))
-        {
-            if (index == counter)
-            {
-                return player == member;
-            }
-            counter++;
-        }
-    }
-    // not enough
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
-    {
-        Player* member = ref->GetSource();
-        if (!group->IsAssistant(member->GetGUID()) && IsRangedDps(member))
-        {
-            if (index == counter)
-            {
-                return player == member;
-            }
-            counter++;
-        }
-    }
-    return false;
+    ObjectGuid rangedDps = sGroupRoleRoster->GetRangedDps(group, index);
+    return !rangedDps.IsEmpty() && rangedDps == player->GetGUID();
 }
 
 bool PlayerbotAI::HasAggro(Unit* unit)
@@ -1546,18 +1500,12 @@ int32 PlayerbotAI::GetGroupSlotIndex(Player* player)
     {
         return -1;
     }
-    Group::MemberSlotList const& slots = group->GetMemberSlots();
-    int counter = 0;
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+    GroupRosterMember member;
+    if (!sGroupRoleRoster->GetMember(group, player, member))
     {
-        Player* member = ref->GetSource();
-        if (player == member)
-        {
-            return counter;
-        }
-        counter++;
+        return 0;
     }
-    return 0;
+    return member.slot;
 }
 
 int32 PlayerbotAI::GetRangedIndex(Player* player)
@@ -1571,21 +1519,12 @@ int32 PlayerbotAI::GetRangedIndex(Player* player)
     {
         return -1;
     }
-    Group::MemberSlotList const& slots = group->GetMemberSlots();
-    int counter = 0;
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+    GroupRosterMember member;
+    if (!sGroupRoleRoster->GetMember(group, player, member))
     {
-        Player* member = ref->GetSource();
-        if (player == member)
-        {
-            return counter;
-        }
-        if (IsRanged(member))
-        {
-            counter++;
-        }
+        return 0;
     }
-    return 0;
+    return member.rangedBefore;
 }
 
 int32 PlayerbotAI::GetClassIndex(Player* player, uint8_t cls)
@@ -1599,22 +1538,14 @@ int32 PlayerbotAI::GetClassIndex(Player* player, uint8_t cls)
     {
         return -1;
     }
-    Group::MemberSlotList const& slots = group->GetMemberSlots();
-    int counter = 0;
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+    GroupRosterMember member;
+    if (!sGroupRoleRoster->GetMember(group, player, member))
     {
-        Player* member = ref->GetSource();
-        if (player == member)
-        {
-            return counter;
-        }
-        if (member->getClass() == cls)
-        {
-            counter++;
-        }
+        return 0;
     }
-    return 0;
+    return member.classBefore;
 }
+
 int32 PlayerbotAI::GetRangedDpsIndex(Player* player)
 {
     if (!IsRangedDps(player))
@@ -1626,21 +1557,12 @@ int32 PlayerbotAI::GetRangedDpsIndex(Player* player)
     {
         return -1;
     }
-    Group::MemberSlotList const& slots = group->GetMemberSlots();
-    int counter = 0;
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+    GroupRosterMember member;
+    if (!sGroupRoleRoster->GetMember(group, player, member))
     {
-        Player* member = ref->GetSource();
-        if (player == member)
-        {
-            return counter;
-        }
-        if (IsRangedDps(member))
-        {
-            counter++;
-        }
+        return 0;
     }
-    return 0;
+    return member.rangedDpsBefore;
 }
 
 int32 PlayerbotAI::GetMeleeIndex(Player* player)
@@ -1654,21 +1576,12 @@ int32 PlayerbotAI::GetMeleeIndex(Player* player)
     {
         return -1;
     }
-    Group::MemberSlotList const& slots = group->GetMemberSlots();
-    int counter = 0;
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+    GroupRosterMember member;
+    if (!sGroupRoleRoster->GetMember(group, player, member))
     {
-        Player* member = ref->GetSource();
-        if (player == member)
-        {
-            return counter;
-        }
-        if (!IsRanged(member))
-        {
-            counter++;
-        }
+        return 0;
     }
-    return 0;
+    return member.meleeBefore;
 }
 
 bool PlayerbotAI::IsTank(Player* player)
@@ -1677,7 +1590,7 @@ bool PlayerbotAI::IsTank(Player* player)
     if (botAi)
         return botAi->ContainsStrategy(STRATEGY_TYPE_TANK);
 
-    int tab = AiFactory::GetPlayerSpecTab(player);
+    int tab = sGroupRoleRoster->GetSpecTab(player);
     switch (player->getClass())
     {
         case CLASS_DEATH_KNIGHT:
@@ -1715,7 +1628,7 @@ bool PlayerbotAI::IsHeal(Player* player)
     if (botAi)
         return botAi->ContainsStrategy(STRATEGY_TYPE_HEAL);
 
-    int tab = AiFactory::GetPlayerSpecTab(player);
+    int tab = sGroupRoleRoster->GetSpecTab(player);
     switch (player->getClass())
     {
         case CLASS_PRIEST:
@@ -1752,7 +1665,7 @@ bool PlayerbotAI::IsDps(Player* player)
     if (botAi)
         return botAi->ContainsStrategy(STRATEGY_TYPE_DPS);
 
-    int tab = AiFactory::GetPlayerSpecTab(player);
+    int tab = sGroupRoleRoster->GetSpecTab(player);
     switch (player->getClass())
     {
         case CLASS_MAGE:
@@ -2118,43 +2031,31 @@ bool PlayerbotAI::HasAura(std::string const name, Unit* unit, bool maxStack, boo
     if (!unit)
         return false;
 
-    std::wstring wnamepart;
-    if (!Utf8toWStr(name, wnamepart))
-        return 0;
-
-    wstrToLower(wnamepart);
-
     int auraAmount = 0;
 
-    for (uint32 auraType = SPELL_AURA_BIND_SIGHT; auraType < TOTAL_AURAS; auraType++)
+    Unit::AuraApplicationMap& appliedAuras = unit->GetAppliedAuras();
+    for (uint32 spellId : sSpellNameIndex->Find(name))
     {
-        Unit::AuraEffectList const& auras = unit->GetAuraEffectsByType((AuraType)auraType);
-        if (auras.empty())
-            continue;
-
-        for (AuraEffect const* aurEff : auras)
+        Unit::AuraApplicationMapBounds bounds = appliedAuras.equal_range(spellId);
+        for (Unit::AuraApplicationMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
         {
-            SpellInfo const* spellInfo = aurEff->GetSpellInfo();
+            AuraApplication* aurApp = itr->second;
+            for (uint8 effIndex = EFFECT_0; effIndex < MAX_SPELL_EFFECTS; ++effIndex)
+            {
+                if (!aurApp->HasEffect(effIndex))
+                    continue;
 
-            std::string_view const auraName = spellInfo->SpellName[0];
-            if (auraName.empty() || auraName.length() != wnamepart.length() || !Utf8FitTo(auraName, wnamepart))
-                continue;
+                AuraEffect const* aurEff = aurApp->GetBase()->GetEffect(effIndex);
+                if (!aurEff || aurEff->GetAuraType() == SPELL_AURA_NONE || !IsRealAura(bot, aurEff, unit))
+                    continue;
 
-            if (IsRealAura(bot, aurEff, unit))
-            {
-                if (checkIsOwner && aurEff)
-                {
-                    if (aurEff->GetCasterGUID() != bot->GetGUID())
-                        continue;
-                }
+                if (checkIsOwner && aurEff->GetCasterGUID() != bot->GetGUID())
+                    continue;
 
-                if (checkDuration && aurEff)
-                {
-                    if (aurEff->GetBase()->GetDuration() == -1)
-                    {
-                        continue;
-                    }
-                }
+                if (checkDuration && aurEff->GetBase()->GetDuration() == -1)
+                    continue;
+
+                SpellInfo const* spellInfo = aurEff->GetSpellInfo();
                 uint32 maxStackAmount = spellInfo->StackAmount;
                 uint32 maxProcCharges = spellInfo->ProcCharges;
 
@@ -2205,49 +2106,31 @@ Aura* PlayerbotAI::GetAura(std::string const name, Unit* unit, bool checkIsOwner
     if (!unit)
         return nullptr;
 
-    std::wstring wnamepart;
-    if (!Utf8toWStr(name, wnamepart))
-        return nullptr;
-
-    wstrToLower(wnamepart);
-
-    for (uint32 auraType = SPELL_AURA_BIND_SIGHT; auraType < TOTAL_AURAS; auraType++)
+    Unit::AuraApplicationMap& appliedAuras = unit->GetAppliedAuras();
+    for (uint32 spellId : sSpellNameIndex->Find(name))
     {
-        Unit::AuraEffectList const& auras = unit->GetAuraEffectsByType((AuraType)auraType);
-        if (auras.empty())
-            continue;
-
-        for (AuraEffect const* aurEff : auras)
+        Unit::AuraApplicationMapBounds bounds = appliedAuras.equal_range(spellId);
+        for (Unit::AuraApplicationMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
         {
-            SpellInfo const* spellInfo = aurEff->GetSpellInfo();
+            AuraApplication* aurApp = itr->second;
+            for (uint8 effIndex = EFFECT_0; effIndex < MAX_SPELL_EFFECTS; ++effIndex)
+            {
+                if (!aurApp->HasEffect(effIndex))
+                    continue;
 
-            std::string const auraName = spellInfo->SpellName[0];
-            if (auraName.empty() || auraName.length() != wnamepart.length() || !Utf8FitTo(auraName, wnamepart))
-                continue;
+                AuraEffect const* aurEff = aurApp->GetBase()->GetEffect(effIndex);
+                if (!aurEff || aurEff->GetAuraType() == SPELL_AURA_NONE || !IsRealAura(bot, aurEff, unit))
+                    continue;
 
-            if (IsRealAura(bot, aurEff, unit))
-            {
-                if (checkIsOwner && aurEff)
-                {
-                    if (aurEff->GetCasterGUID() != bot->GetGUID())
-                        continue;
-                }
+                if (checkIsOwner && aurEff->GetCasterGUID() != bot->GetGUID())
+                    continue;
 
-                if (checkDuration && aurEff)
-                {
-                    if (aurEff->GetBase()->GetDuration() == -1)
-                    {
-                        continue;
-                    }
-                }
+                if (checkDuration && aurEff->GetBase()->GetDuration() == -1)
+                    continue;
+
+                if (checkStack != -1 && aurEff->GetBase()->GetStackAmount() < checkStack)
+                    continue;
 
-                if (checkStack != -1 && aurEff)
-                {
-                    if (aurEff->GetBase()->GetStackAmount() < checkStack)
-                    {
-                        continue;
-                    }
-                }
                 return aurEff->GetBase();
             }
         }
@@ -2279,6 +2162,45 @@ bool PlayerbotAI::HasAnyAuraOf(Unit* player, ...)
     return false;
 }
 
+CastCheckState::CastCheckState(Player* bot, Unit* target, SpellInfo const* spellInfo)
+    : botX(bot->GetPositionX()),
+      botY(bot->GetPositionY()),
+      botZ(bot->GetPositionZ()),
+      botO(bot->GetOrientation()),
+      targetX(target->GetPositionX()),
+      targetY(target->GetPositionY()),
+      targetZ(target->GetPositionZ()),
+      targetO(target->GetOrientation()),
+      power(bot->GetPower(bot->getPowerType())),
+      runes(0),
+      comboPoints(bot->GetComboPoints()),
+      comboTarget(bot->GetComboTargetGUID()),
+      botAuras(bot->GetAppliedAuras().size()),
+      targetAuras(target->GetAppliedAuras().size()),
+      botAuraState(bot->GetUInt32Value(UNIT_FIELD_AURASTATE)),
+      targetAuraState(target->GetUInt32Value(UNIT_FIELD_AURASTATE))
+{
+    if (bot->getClass() == CLASS_DEATH_KNIGHT)
+    {
+        for (uint8 i = 0; i < MAX_RUNES; ++i)
+            runes |= ((bot->GetRuneCooldown(i) ? 0 : 1) | (uint32(bot->GetCurrentRune(i)) << 1)) << (i * 3);
+    }
+
+    flags = (bot->IsInCombat() ? 1 : 0) | (bot->IsMounted() ? 2 : 0) | (target->IsAlive() ? 4 : 0) |
+            (target->IsInCombat() ? 8 : 0) | (bot->GetGlobalCooldownMgr().HasGlobalCooldown(spellInfo) ? 16 : 0) |
+            (uint32(bot->GetShapeshiftForm()) << 8);
+}
+
+bool CastCheckState::operator==(CastCheckState const& other) const
+{
+    return botX == other.botX && botY == other.botY && botZ == other.botZ && botO == other.botO &&
+           targetX == other.targetX && targetY == other.targetY && targetZ == other.targetZ &&
+           targetO == other.targetO && power == other.power && runes == other.runes &&
+           comboPoints == other.comboPoints && comboTarget == other.comboTarget && botAuras == other.botAuras &&
+           targetAuras == other.targetAuras && botAuraState == other.botAuraState &&
+           targetAuraState == other.targetAuraState && flags == other.flags;
+}
+
 bool PlayerbotAI::CanCastSpell(std::string const name, Unit* target, Item* itemTarget)
 {
     return CanCastSpell(aiObjectContext->GetValue<uint32>("spell id", name)->Get(), target, true, itemTarget);
@@ -2428,30 +2350,60 @@ bool PlayerbotAI::CanCastSpell(uint32 spellid, Unit* target, bool checkHasSpell,
         }
     }
 
-    Unit* oldSel = bot->GetSelectedUnit();
-    Spell* spell = new Spell(bot, spellInfo, TRIGGERED_NONE);
-
-    spell->m_targets.SetUnitTarget(target);
-    spell->m_CastItem = castItem;
-    if (itemTarget == nullptr)
+    if (!castItem && !HasReagentsFor(spellInfo))
     {
+        if (!sPlayerbotAIConfig->logInGroupOnly || (bot->GetGroup() && HasRealPlayerMaster()))
+        {
+            LOG_DEBUG("playerbots", "Can cast spell failed. No reagents. - target name: {}, spellid: {}, bot name: {}",
+                      target->GetName(), spellid, bot->GetName());
+        }
+        return false;
+    }
+
+    // resolved here rather than in CheckCast, so the item the check ran with is part of the cache key
+    if (!itemTarget)
         itemTarget = aiObjectContext->GetValue<Item*>("item for spell", spellid)->Get();
-        ;
+
+    // the full spell check is only repeated when something it depends on changed since the last one
+    CastCheckKey key;
+    key.spellId = spellid;
+    key.target = target->GetGUID();
+    key.itemTarget = itemTarget ? itemTarget->GetGUID() : ObjectGuid::Empty;
+    key.castItem = castItem ? castItem->GetGUID() : ObjectGuid::Empty;
+
+    CastCheckState state(bot, target, spellInfo);
+    uint32 now = getMSTime();
+    castChecks.fetch_add(1, std::memory_order_relaxed);
+
+    SpellCastResult result;
+    std::unordered_map<CastCheckKey, CastCheckEntry, CastCheckKeyHash>::iterator i = castCheckCache.find(key);
+    if (i != castCheckCache.end() && i->second.state == state &&
+        getMSTimeDiff(i->second.time, now) < CAST_CHECK_CACHE_TIME)
+    {
+        result = i->second.result;
+        castChecksCached.fetch_add(1, std::memory_order_relaxed);
     }
-    spell->m_targets.SetItemTarget(itemTarget);
+    else
+    {
+        result = CheckCast(spellInfo, target, itemTarget, castItem);
 
-    SpellCastResult result = spell->CheckCast(true);
-    delete spell;
+        if (i == castCheckCache.end() && castCheckCache.size() >= CAST_CHECK_CACHE_MAX)
+        {
+            for (i = castCheckCache.begin(); i != castCheckCache.end();)
+            {
+                if (getMSTimeDiff(i->second.time, now) >= CAST_CHECK_CACHE_TIME)
+                    i = castCheckCache.erase(i);
+                else
+                    ++i;
+            }
 
-    // if (!sPlayerbotAIConfig->logInGroupOnly || (bot->GetGroup() && HasRealPlayerMaster())) {
-    //     if (result != SPELL_FAILED_NOT_READY && result != SPELL_CAST_OK) {
-    //         LOG_DEBUG("playerbots", "CanCastSpell - target name: {}, spellid: {}, bot name: {}, result: {}",
-    //             target->GetName(), spellid, bot->GetName(), result);
-    //     }
-    // }
+            if (castCheckCache.size() >= CAST_CHECK_CACHE_MAX)
+                castCheckCache.clear();
+        }
 
-    if (oldSel)
-        bot->SetSelection(oldSel->GetGUID());
+        CastCheckEntry entry{state, result, now};
+        castCheckCache.insert_or_assign(key, entry);
+    }
 
     switch (result)
     {
@@ -2476,6 +2428,41 @@ bool PlayerbotAI::CanCastSpell(uint32 spellid, Unit* target, bool checkHasSpell,
     }
 }
 
+bool PlayerbotAI::HasReagentsFor(SpellInfo const* spellInfo)
+{
+    if (bot->CanNoReagentCast(spellInfo))
+        return true;
+
+    for (uint32 i = 0; i < MAX_SPELL_REAGENTS; ++i)
+    {
+        if (spellInfo->Reagent[i] <= 0)
+            continue;
+
+        if (!bot->HasItemCount(spellInfo->Reagent[i], spellInfo->ReagentCount[i]))
+            return false;
+    }
+
+    return true;
+}
+
+SpellCastResult PlayerbotAI::CheckCast(SpellInfo const* spellInfo, Unit* target, Item* itemTarget, Item* castItem)
+{
+    Unit* oldSel = bot->GetSelectedUnit();
+    Spell* spell = new Spell(bot, spellInfo, TRIGGERED_NONE);
+
+    spell->m_targets.SetUnitTarget(target);
+    spell->m_CastItem = castItem;
+    spell->m_targets.SetItemTarget(itemTarget);
+
+    SpellCastResult result = spell->CheckCast(true);
+    delete spell;
+
+    if (oldSel)
+        bot->SetSelection(oldSel->GetGUID());
+
+    return result;
+}
+
 bool PlayerbotAI::CanCastSpell(uint32 spellid, GameObject* goTarget, uint8 effectMask, bool checkHasSpell)
 {
     if (!spellid)
@@ -3443,29 +3430,7 @@ GuilderType PlayerbotAI::GetGuilderType()
 
 bool PlayerbotAI::HasPlayerNearby(WorldPosition* pos, float range)
 {
-    float sqRange = range * range;
-    bool nearPlayer = false;
-    for (auto& player : sRandomPlayerbotMgr->GetPlayers())
-    {
-        if (!player->IsGameMaster() || player->isGMVisible())
-        {
-            if (player->GetMapId() != bot->GetMapId())
-                continue;
-
-            if (pos->sqDistance(WorldPosition(player)) < sqRange)
-                nearPlayer = true;
-
-            // if player is far check farsight/cinematic camera
-            WorldObject* viewObj = player->GetViewpoint();
-            if (viewObj && viewObj != player)
-            {
-                if (pos->sqDistance(WorldPosition(viewObj)) < sqRange)
-                    nearPlayer = true;
-            }
-        }
-    }
-
-    return nearPlayer;
+    return sRealPlayerGrid->HasPlayerNearby(bot->GetMapId(), pos->getX(), pos->getY(), pos->getZ(), range);
 }
 
 bool PlayerbotAI::HasPlayerNearby(float range)
@@ -3476,21 +3441,8 @@ bool PlayerbotAI::HasPlayerNearby(float range)
 
 bool PlayerbotAI::HasManyPlayersNearby(uint32 trigerrValue, float range)
 {
-    float sqRange = range * range;
-    uint32 found = 0;
-
-    for (auto& player : sRandomPlayerbotMgr->GetPlayers())
-    {
-        if ((!player->IsGameMaster() || player->isGMVisible()) && sServerFacade->GetDistance2d(player, bot) < sqRange)
-        {
-            found++;
-
-            if (found >= trigerrValue)
-                return true;
-        }
-    }
-
-    return false;
+    return sRealPlayerGrid->HasPlayersNearby(bot->GetMapId(), bot->GetPositionX(), bot->GetPositionY(), range,
+                                             trigerrValue);
 }
 
 inline bool HasRealPlayers(Map* map)
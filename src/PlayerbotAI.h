@@ -6,8 +6,10 @@
 #ifndef _PLAYERBOT_PLAYERbotAI_H
 #define _PLAYERBOT_PLAYERbotAI_H
 
+#include <atomic>
 #include <queue>
 #include <stack>
+#include <unordered_map>
 
 #include "Chat.h"
 #include "ChatFilter.h"
@@ -20,6 +22,7 @@
 #include "PlayerbotSecurity.h"
 #include "PlayerbotTextMgr.h"
 #include "SpellAuras.h"
+#include "SpellBook.h"
 #include "WorldPacket.h"
 
 class AiObjectContext;
@@ -319,6 +322,60 @@ private:
     time_t time;
 };
 
+#define CAST_CHECK_CACHE_TIME 1000  // ms a spell check result is reused while nothing it depends on changed
+#define CAST_CHECK_CACHE_MAX 256
+
+struct CastCheckKey
+{
+    bool operator==(CastCheckKey const& other) const
+    {
+        return spellId == other.spellId && target == other.target && itemTarget == other.itemTarget &&
+               castItem == other.castItem;
+    }
+
+    uint32 spellId;
+    ObjectGuid target;
+    ObjectGuid itemTarget;
+    ObjectGuid castItem;
+};
+
+struct CastCheckKeyHash
+{
+    size_t operator()(CastCheckKey const& key) const
+    {
+        size_t hash = std::hash<uint32>()(key.spellId);
+        hash = hash * 31 + std::hash<ObjectGuid>()(key.target);
+        hash = hash * 31 + std::hash<ObjectGuid>()(key.itemTarget);
+        return hash * 31 + std::hash<ObjectGuid>()(key.castItem);
+    }
+};
+
+// What Spell::CheckCast looks at on the caster and the target that changes while a bot fights:
+// positions, power, runes, combo points, global cooldown, auras and aura states, combat, mount and shapeshift form.
+struct CastCheckState
+{
+    CastCheckState(Player* bot, Unit* target, SpellInfo const* spellInfo);
+
+    bool operator==(CastCheckState const& other) const;
+
+    float botX, botY, botZ, botO;
+    float targetX, targetY, targetZ, targetO;  // facing decides behind checks
+    uint32 power;
+    uint32 runes;  // ready bit and type of each rune
+    uint32 comboPoints;
+    ObjectGuid comboTarget;
+    uint32 botAuras, targetAuras;
+    uint32 botAuraState, targetAuraState;
+    uint32 flags;
+};
+
+struct CastCheckEntry
+{
+    CastCheckState state;
+    SpellCastResult result;
+    uint32 time;
+};
+
 class PlayerbotAI : public PlayerbotAIBase
 {
 public:
@@ -471,6 +528,7 @@ public:
 
     void SetMaster(Player* newMaster) { master = newMaster; }
     AiObjectContext* GetAiObjectContext() { return aiObjectContext; }
+    SpellBook* GetSpellBook() { return &spellBook; }
     ChatHelper* GetChatHelper() { return &chatHelper; }
     bool IsOpposing(Player* player);
     static bool IsOpposing(uint8 race1, uint8 race2);
@@ -483,6 +541,9 @@ public:
     bool CanMove();
     bool IsInRealGuild();
     static std::vector<std::string> dispel_whitelist;
+    // CanCastSpell checks done by all bots, and how many of them reused an earlier Spell::CheckCast result
+    static std::atomic<uint64> castChecks;
+    static std::atomic<uint64> castChecksCached;
     bool EqualLowercaseName(std::string s1, std::string s2);
     InventoryResult CanEquipItem(uint8 slot, uint16& dest, Item* pItem, bool swap, bool not_loading = true) const;
     uint8 FindEquipSlot(ItemTemplate const* proto, uint32 slot, bool swap) const;
@@ -491,6 +552,8 @@ private:
     static void _fillGearScoreData(Player* player, Item* item, std::vector<uint32>* gearScore, uint32& twoHandScore,
                                    bool mixed = false);
     bool IsTellAllowed(PlayerbotSecurityLevel securityLevel = PLAYERBOT_SECURITY_ALLOW_ALL);
+    bool HasReagentsFor(SpellInfo const* spellInfo);
+    SpellCastResult CheckCast(SpellInfo const* spellInfo, Unit* target, Item* itemTarget, Item* castItem);
 
 protected:
     Player* bot;
@@ -516,6 +579,8 @@ protected:
     bool inCombat = false;
     BotCheatMask cheatMask = BotCheatMask::none;
     Position jumpDestination = Position();
+    std::unordered_map<CastCheckKey, CastCheckEntry, CastCheckKeyHash> castCheckCache;
+    SpellBook spellBook;
 };
 
 #endif
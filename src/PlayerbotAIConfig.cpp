@@ -8,11 +8,14 @@
 #include <iostream>
 
 #include "Config.h"
+#include "GuildTaskMgr.h"
 #include "PlayerbotDungeonSuggestionMgr.h"
 #include "PlayerbotFactory.h"
+#include "PlayerbotLogWriter.h"
 #include "Playerbots.h"
 #include "RandomItemMgr.h"
 #include "RandomPlayerbotFactory.h"
+#include "SpellNameIndex.h"
 #include "Talentspec.h"
 
 template <class T>
@@ -141,6 +144,11 @@ bool PlayerbotAIConfig::Initialize()
         sConfigMgr->GetOption<int32>("AiPlayerbot.RandomBotCountChangeMaxInterval", 2 * HOUR);
     minRandomBotInWorldTime = sConfigMgr->GetOption<int32>("AiPlayerbot.MinRandomBotInWorldTime", 2 * HOUR);
     maxRandomBotInWorldTime = sConfigMgr->GetOption<int32>("AiPlayerbot.MaxRandomBotInWorldTime", 12 * HOUR);
+    randomBotEventFlushInterval = sConfigMgr->GetOption<int32>("AiPlayerbot.RandomBotEventFlushInterval", 5);
+    botStoreFlushInterval = sConfigMgr->GetOption<int32>("AiPlayerbot.BotStoreFlushInterval", 5);
+    randomBotLoginBudget = sConfigMgr->GetOption<int32>("AiPlayerbot.RandomBotLoginBudget", 5000);
+    randomBotLoginMaxInFlight = sConfigMgr->GetOption<int32>("AiPlayerbot.RandomBotLoginMaxInFlight", 50);
+    randomBotLoginWaitForWorld = sConfigMgr->GetOption<bool>("AiPlayerbot.RandomBotLoginWaitForWorld", true);
     minRandomBotRandomizeTime = sConfigMgr->GetOption<int32>("AiPlayerbot.MinRandomBotRandomizeTime", 2 * HOUR);
     maxRandomBotRandomizeTime = sConfigMgr->GetOption<int32>("AiPlayerbot.MaxRandomBotRandomizeTime", 14 * 24 * HOUR);
     minRandomBotChangeStrategyTime =
@@ -200,6 +208,7 @@ bool PlayerbotAIConfig::Initialize()
 
     commandServerPort = sConfigMgr->GetOption<int32>("AiPlayerbot.CommandServerPort", 8888);
     perfMonEnabled = sConfigMgr->GetOption<bool>("AiPlayerbot.PerfMonEnabled", false);
+    perfMonDumpInterval = sConfigMgr->GetOption<int32>("AiPlayerbot.PerfMonDumpInterval", 0);
 
     LOG_INFO("server.loading", "---------------------------------------");
     LOG_INFO("server.loading", "          Loading TalentSpecs          ");
@@ -392,6 +401,8 @@ bool PlayerbotAIConfig::Initialize()
     sRandomItemMgr->InitAfterAhBot();
     sPlayerbotTextMgr->LoadBotTexts();
     sPlayerbotTextMgr->LoadBotTextChance();
+    sGuildTaskMgr->LoadTasks();
+    sSpellNameIndex->Load();
 
     if (!sPlayerbotAIConfig->autoDoQuests)
     {
@@ -460,19 +471,6 @@ bool PlayerbotAIConfig::openLog(std::string const fileName, char const* mode)
     if (!hasLog(fileName))
         return false;
 
-    auto logFileIt = logFiles.find(fileName);
-    if (logFileIt == logFiles.end())
-    {
-        logFiles.insert(std::make_pair(fileName, std::make_pair(nullptr, false)));
-        logFileIt = logFiles.find(fileName);
-    }
-
-    FILE* file = logFileIt->second.first;
-    bool fileOpen = logFileIt->second.second;
-
-    if (fileOpen)  // close log file
-        fclose(file);
-
     std::string m_logsDir = sConfigMgr->GetOption<std::string>("LogsDir", "", false);
     if (!m_logsDir.empty())
     {
@@ -480,35 +478,39 @@ bool PlayerbotAIConfig::openLog(std::string const fileName, char const* mode)
             m_logsDir.append("/");
     }
 
-    file = fopen((m_logsDir + fileName).c_str(), mode);
-    fileOpen = true;
-
-    logFileIt->second.first = file;
-    logFileIt->second.second = fileOpen;
-
-    return true;
+    return sPlayerbotLogWriter->Open(fileName, m_logsDir + fileName, mode);
 }
 
+bool PlayerbotAIConfig::isLogOpen(std::string const fileName) { return sPlayerbotLogWriter->IsOpen(fileName); }
+
 void PlayerbotAIConfig::log(std::string const fileName, char const* str, ...)
 {
-    if (!str)
+    if (!str || !hasLog(fileName))
         return;
 
-    std::lock_guard<std::mutex> guard(m_logMtx);
-
     if (!isLogOpen(fileName) && !openLog(fileName, "a"))
         return;
 
-    FILE* file = logFiles.find(fileName)->second.first;
+    // formatted on the calling thread, the writer thread only does the file io
+    thread_local std::string line;
 
     va_list ap;
     va_start(ap, str);
-    vfprintf(file, str, ap);
-    fprintf(file, "\n");
-    va_end(ap);
-    fflush(file);
 
-    fflush(stdout);
+    va_list size_ap;
+    va_copy(size_ap, ap);
+    int size = vsnprintf(nullptr, 0, str, size_ap);
+    va_end(size_ap);
+
+    if (size >= 0)
+    {
+        line.resize(size + 1);
+        vsnprintf(&line[0], size + 1, str, ap);
+        line.resize(size);
+        sPlayerbotLogWriter->Write(fileName, line);
+    }
+
+    va_end(ap);
 }
 
 void PlayerbotAIConfig::loadWorldBuf(uint32 factionId1, uint32 classId1, uint32 minLevel1, uint32 maxLevel1)
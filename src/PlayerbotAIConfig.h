@@ -86,6 +86,9 @@ public:
     uint32 minRandomBots, maxRandomBots;
     uint32 randomBotUpdateInterval, randomBotCountChangeMinInterval, randomBotCountChangeMaxInterval;
     uint32 minRandomBotInWorldTime, maxRandomBotInWorldTime;
+    uint32 randomBotEventFlushInterval, botStoreFlushInterval;
+    uint32 randomBotLoginBudget, randomBotLoginMaxInFlight;
+    bool randomBotLoginWaitForWorld;
     uint32 minRandomBotRandomizeTime, maxRandomBotRandomizeTime;
     uint32 minRandomBotChangeStrategyTime, maxRandomBotChangeStrategyTime;
     uint32 minRandomBotReviveTime, maxRandomBotReviveTime;
@@ -161,9 +164,7 @@ public:
 
     uint32 iterationsPerTick;
 
-    std::mutex m_logMtx;
     std::vector<std::string> allowedLogFiles;
-    std::unordered_map<std::string, std::pair<FILE*, bool>> logFiles;
 
     std::vector<std::string> botCheats;
     uint32 botCheatMask = 0;
@@ -181,6 +182,7 @@ public:
 
     uint32 commandServerPort;
     bool perfMonEnabled;
+    uint32 perfMonDumpInterval;
 
     bool enableGreet;
     bool summonWhenGroup;
@@ -249,11 +251,7 @@ public:
         return std::find(allowedLogFiles.begin(), allowedLogFiles.end(), fileName) != allowedLogFiles.end();
     };
     bool openLog(std::string const fileName, char const* mode = "a");
-    bool isLogOpen(std::string const fileName)
-    {
-        auto it = logFiles.find(fileName);
-        return it != logFiles.end() && it->second.second;
-    }
+    bool isLogOpen(std::string const fileName);
     void log(std::string const fileName, const char* str, ...);
 
     void loadWorldBuf(uint32 factionId, uint32 classId, uint32 minLevel, uint32 maxLevel);
@@ -9,55 +9,86 @@
 
 #include "Playerbots.h"
 
+#define PLAYERBOT_DB_STORE_FLUSH_BATCH 500
+
 void PlayerbotDbStore::Load(PlayerbotAI* botAI)
 {
     ObjectGuid::LowType guid = botAI->GetBot()->GetGUID().GetCounter();
 
-    PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_DB_STORE);
-    stmt->SetData(0, guid);
-    if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
+    PlayerbotDbStoreRows rows;
+    bool found = false;
     {
-        botAI->ClearStrategies(BOT_STATE_COMBAT);
-        botAI->ClearStrategies(BOT_STATE_NON_COMBAT);
-        botAI->ChangeStrategy("+chat", BOT_STATE_COMBAT);
-        botAI->ChangeStrategy("+chat", BOT_STATE_NON_COMBAT);
+        std::lock_guard<std::mutex> guard(lock);
+        std::unordered_map<uint32, PlayerbotDbStoreRows>::iterator i = stored.find(guid);
+        if (i != stored.end())
+        {
+            rows = i->second;
+            found = true;
+        }
+    }
 
-        std::vector<std::string> values;
-        do
+    // bots saved or loaded before are known without asking the database
+    if (!found)
+    {
+        PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_DB_STORE);
+        stmt->SetData(0, guid);
+        if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
         {
-            Field* fields = result->Fetch();
-            std::string const key = fields[0].Get<std::string>();
-            std::string const value = fields[1].Get<std::string>();
-
-            if (key == "value")
-                values.push_back(value);
-            else if (key == "co")
-                botAI->ChangeStrategy(value, BOT_STATE_COMBAT);
-            else if (key == "nc")
-                botAI->ChangeStrategy(value, BOT_STATE_NON_COMBAT);
-            else if (key == "dead")
-                botAI->ChangeStrategy(value, BOT_STATE_DEAD);
-        } while (result->NextRow());
-
-        botAI->GetAiObjectContext()->Load(values);
+            do
+            {
+                Field* fields = result->Fetch();
+                rows.push_back(std::make_pair(fields[0].Get<std::string>(), fields[1].Get<std::string>()));
+            } while (result->NextRow());
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+        rows = stored.emplace(guid, rows).first->second;
     }
+
+    if (rows.empty())
+        return;
+
+    botAI->ClearStrategies(BOT_STATE_COMBAT);
+    botAI->ClearStrategies(BOT_STATE_NON_COMBAT);
+    botAI->ChangeStrategy("+chat", BOT_STATE_COMBAT);
+    botAI->ChangeStrategy("+chat", BOT_STATE_NON_COMBAT);
+
+    std::vector<std::string> values;
+    for (PlayerbotDbStoreRows::iterator i = rows.begin(); i != rows.end(); ++i)
+    {
+        std::string const& key = i->first;
+        std::string const& value = i->second;
+
+        if (key == "value")
+            values.push_back(value);
+        else if (key == "co")
+            botAI->ChangeStrategy(value, BOT_STATE_COMBAT);
+        else if (key == "nc")
+            botAI->ChangeStrategy(value, BOT_STATE_NON_COMBAT);
+        else if (key == "dead")
+            botAI->ChangeStrategy(value, BOT_STATE_DEAD);
+    }
+
+    botAI->GetAiObjectContext()->Load(values);
 }
 
 void PlayerbotDbStore::Save(PlayerbotAI* botAI)
 {
     ObjectGuid::LowType guid = botAI->GetBot()->GetGUID().GetCounter();
 
-    Reset(botAI);
+    PlayerbotDbStoreRows rows;
 
     std::vector<std::string> data = botAI->GetAiObjectContext()->Save();
     for (std::vector<std::string>::iterator i = data.begin(); i != data.end(); ++i)
     {
-        SaveValue(guid, "value", *i);
+        rows.push_back(std::make_pair("value", *i));
     }
 
-    SaveValue(guid, "co", FormatStrategies("co", botAI->GetStrategies(BOT_STATE_COMBAT)));
-    SaveValue(guid, "nc", FormatStrategies("nc", botAI->GetStrategies(BOT_STATE_NON_COMBAT)));
-    SaveValue(guid, "dead", FormatStrategies("dead", botAI->GetStrategies(BOT_STATE_DEAD)));
+    rows.push_back(std::make_pair("co", FormatStrategies("co", botAI->GetStrategies(BOT_STATE_COMBAT))));
+    rows.push_back(std::make_pair("nc", FormatStrategies("nc", botAI->GetStrategies(BOT_STATE_NON_COMBAT))));
+    rows.push_back(std::make_pair("dead", FormatStrategies("dead", botAI->GetStrategies(BOT_STATE_DEAD))));
+
+    Store(guid, rows);
 }
 
 std::string const PlayerbotDbStore::FormatStrategies(std::string const type, std::vector<std::string> strategies)
@@ -74,16 +105,98 @@ void PlayerbotDbStore::Reset(PlayerbotAI* botAI)
 {
     ObjectGuid::LowType guid = botAI->GetBot()->GetGUID().GetCounter();
 
-    PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_CUSTOM_STRATEGY);
-    stmt->SetData(0, guid);
-    PlayerbotsDatabase.Execute(stmt);
+    Store(guid, PlayerbotDbStoreRows());
+}
+
+void PlayerbotDbStore::Store(uint32 guid, PlayerbotDbStoreRows const& rows)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        std::unordered_map<uint32, PlayerbotDbStoreRows>::iterator i = stored.find(guid);
+        if (i != stored.end() && i->second == rows)
+            return;
+
+        stored[guid] = rows;
+        pending[guid] = rows;
+    }
+
+    if (!sPlayerbotAIConfig->botStoreFlushInterval)
+        Flush();
+}
+
+void PlayerbotDbStore::Update()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (time(nullptr) - lastFlush < sPlayerbotAIConfig->botStoreFlushInterval)
+            return;
+    }
+
+    Flush();
 }
 
-void PlayerbotDbStore::SaveValue(uint32 guid, std::string const key, std::string const value)
+void PlayerbotDbStore::Flush(bool direct)
 {
-    PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_INS_DB_STORE);
-    stmt->SetData(0, guid);
-    stmt->SetData(1, key);
-    stmt->SetData(2, value);
-    PlayerbotsDatabase.Execute(stmt);
+    std::map<uint32, PlayerbotDbStoreRows> bots;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        lastFlush = time(nullptr);
+        if (pending.empty())
+            return;
+
+        bots.swap(pending);
+    }
+
+    PlayerbotsDatabaseTransaction trans = PlayerbotsDatabase.BeginTransaction();
+
+    // Changed bots are rewritten in full, their rows have no key to update them by.
+    std::ostringstream deletes, inserts;
+    uint32 deleteRows = 0, insertRows = 0;
+    for (auto& i : bots)
+    {
+        deletes << (deleteRows ? "," : "DELETE FROM playerbots_db_store WHERE guid IN (") << i.first;
+
+        if (++deleteRows == PLAYERBOT_DB_STORE_FLUSH_BATCH)
+        {
+            deletes << ")";
+            trans->Append(deletes.str().c_str());
+            deletes.str("");
+            deleteRows = 0;
+        }
+    }
+
+    if (deleteRows)
+    {
+        deletes << ")";
+        trans->Append(deletes.str().c_str());
+    }
+
+    for (auto& i : bots)
+    {
+        for (auto& row : i.second)
+        {
+            std::string key = row.first;
+            std::string value = row.second;
+            PlayerbotsDatabase.EscapeString(key);
+            PlayerbotsDatabase.EscapeString(value);
+
+            inserts << (insertRows ? "," : "INSERT INTO playerbots_db_store (guid, `key`, `value`) VALUES ") << "("
+                    << i.first << ",'" << key << "','" << value << "')";
+
+            if (++insertRows == PLAYERBOT_DB_STORE_FLUSH_BATCH)
+            {
+                trans->Append(inserts.str().c_str());
+                inserts.str("");
+                insertRows = 0;
+            }
+        }
+    }
+
+    if (insertRows)
+        trans->Append(inserts.str().c_str());
+
+    if (direct)
+        PlayerbotsDatabase.DirectCommitTransaction(trans);
+    else
+        PlayerbotsDatabase.CommitTransaction(trans);
 }
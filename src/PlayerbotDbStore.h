@@ -6,16 +6,23 @@
 #ifndef _PLAYERBOT_PLAYERBOTDBSTORE_H
 #define _PLAYERBOT_PLAYERBOTDBSTORE_H
 
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "Common.h"
 
 class PlayerbotAI;
 
+// key/value rows of one bot in the order they are saved
+typedef std::vector<std::pair<std::string, std::string>> PlayerbotDbStoreRows;
+
 class PlayerbotDbStore
 {
 public:
-    PlayerbotDbStore() {}
+    PlayerbotDbStore() : lastFlush(0) {}
     virtual ~PlayerbotDbStore() {}
     static PlayerbotDbStore* instance()
     {
@@ -26,10 +33,17 @@ public:
     void Save(PlayerbotAI* botAI);
     void Load(PlayerbotAI* botAI);
     void Reset(PlayerbotAI* botAI);
+    void Update();
+    void Flush(bool direct = false);
 
 private:
-    void SaveValue(uint32 guid, std::string const key, std::string const value);
+    void Store(uint32 guid, PlayerbotDbStoreRows const& rows);
     std::string const FormatStrategies(std::string const type, std::vector<std::string> strategies);
+
+    std::unordered_map<uint32, PlayerbotDbStoreRows> stored;  // rows in the database once pending ones are written
+    std::map<uint32, PlayerbotDbStoreRows> pending;           // bots to rewrite on the next flush
+    time_t lastFlush;
+    std::mutex lock;
 };
 
 #define sPlayerbotDbStore PlayerbotDbStore::instance()
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotLogWriter.h"
+
+#include <chrono>
+#include <vector>
+
+#include "Log.h"
+
+bool PlayerbotLogWriter::Open(std::string const fileName, std::string const path, char const* mode)
+{
+    std::lock_guard<std::mutex> writeGuard(writeLock);
+    std::lock_guard<std::mutex> guard(lock);
+
+    // lines queued for the old file still belong to it
+    LogFile& logFile = files[fileName];
+    if (logFile.file)
+    {
+        fwrite(logFile.pending.data(), 1, logFile.pending.size(), logFile.file);
+        fclose(logFile.file);
+    }
+
+    logFile.pending.clear();
+    logFile.file = fopen(path.c_str(), mode);
+    return logFile.file != nullptr;
+}
+
+bool PlayerbotLogWriter::IsOpen(std::string const fileName)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    std::unordered_map<std::string, LogFile>::iterator i = files.find(fileName);
+    return i != files.end() && i->second.file;
+}
+
+void PlayerbotLogWriter::Write(std::string const fileName, std::string const& line)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    std::unordered_map<std::string, LogFile>::iterator i = files.find(fileName);
+    if (i == files.end() || !i->second.file)
+        return;
+
+    LogFile& logFile = i->second;
+
+    // no writer left after shutdown
+    if (stopping)
+    {
+        fprintf(logFile.file, "%s\n", line.c_str());
+        fflush(logFile.file);
+        return;
+    }
+
+    if (logFile.pending.size() + line.size() >= PLAYERBOT_LOG_MAX_PENDING)
+    {
+        ++logFile.dropped;
+        return;
+    }
+
+    logFile.pending.append(line);
+    logFile.pending.push_back('\n');
+
+    if (!writer.joinable())
+        writer = std::thread(&PlayerbotLogWriter::Run, this);
+}
+
+void PlayerbotLogWriter::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (stopping)
+            return;
+
+        stopping = true;
+    }
+
+    wakeUp.notify_all();
+    if (writer.joinable())
+        writer.join();
+}
+
+void PlayerbotLogWriter::Run()
+{
+    bool stop = false;
+    while (!stop)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wakeUp.wait_for(guard, std::chrono::milliseconds(PLAYERBOT_LOG_FLUSH_INTERVAL),
+                            [this] { return stopping; });
+            stop = stopping;
+        }
+
+        std::lock_guard<std::mutex> writeGuard(writeLock);
+
+        std::vector<std::pair<FILE*, std::string>> batch;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (std::unordered_map<std::string, LogFile>::iterator i = files.begin(); i != files.end(); ++i)
+            {
+                LogFile& logFile = i->second;
+                if (logFile.dropped)
+                {
+                    LOG_WARN("playerbots", "{}: {} lines dropped, the log is written slower than it grows", i->first,
+                             logFile.dropped);
+                    logFile.dropped = 0;
+                }
+
+                if (logFile.pending.empty())
+                    continue;
+
+                batch.push_back(std::make_pair(logFile.file, std::string()));
+                batch.back().second.swap(logFile.pending);
+            }
+        }
+
+        for (std::pair<FILE*, std::string>& i : batch)
+        {
+            fwrite(i.second.data(), 1, i.second.size(), i.first);
+            fflush(i.first);
+        }
+    }
+}
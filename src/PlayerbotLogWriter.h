@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTLOGWRITER_H
+#define _PLAYERBOT_PLAYERBOTLOGWRITER_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "Common.h"
+
+#define PLAYERBOT_LOG_FLUSH_INTERVAL 100               // ms between writes
+#define PLAYERBOT_LOG_MAX_PENDING (16 * 1024 * 1024)  // bytes queued per file before lines are dropped
+
+// Writes the csv logs of PlayerbotAIConfig::log from a background thread. Bots only append their
+// lines to a per file buffer, the writer thread writes and flushes each file once per interval.
+class PlayerbotLogWriter
+{
+public:
+    PlayerbotLogWriter() : stopping(false) {}
+    virtual ~PlayerbotLogWriter() { Stop(); }
+    static PlayerbotLogWriter* instance()
+    {
+        static PlayerbotLogWriter instance;
+        return &instance;
+    }
+
+public:
+    bool Open(std::string const fileName, std::string const path, char const* mode);
+    bool IsOpen(std::string const fileName);
+    void Write(std::string const fileName, std::string const& line);
+    void Stop();
+
+private:
+    struct LogFile
+    {
+        FILE* file = nullptr;
+        std::string pending;
+        uint32 dropped = 0;
+    };
+
+    void Run();
+
+    std::unordered_map<std::string, LogFile> files;
+    std::mutex lock;       // files and their pending lines
+    std::mutex writeLock;  // file handles while the writer uses them
+    std::condition_variable wakeUp;
+    std::thread writer;
+    bool stopping;
+};
+
+#define sPlayerbotLogWriter PlayerbotLogWriter::instance()
+
+#endif
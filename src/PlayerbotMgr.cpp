@@ -25,6 +25,7 @@
 #include "PlayerbotSecurity.h"
 #include "Playerbots.h"
 #include "SharedDefines.h"
+#include "StrategyGraph.h"
 #include "WorldSession.h"
 
 PlayerbotHolder::PlayerbotHolder() : PlayerbotAIBase(false) {}
@@ -45,36 +46,43 @@ public:
     PlayerbotHolder* GetPlayerbotHolder() { return playerbotHolder; }
 };
 
-void PlayerbotHolder::AddPlayerBot(ObjectGuid playerGuid, uint32 masterAccountId)
+bool PlayerbotHolder::AddPlayerBot(ObjectGuid playerGuid, uint32 masterAccountId)
 {
     // has bot already been added?
     Player* bot = ObjectAccessor::FindConnectedPlayer(playerGuid);
     if (bot && bot->IsInWorld())
-        return;
+        return false;
 
     uint32 accountId = sCharacterCache->GetCharacterAccountIdByGuid(playerGuid);
     if (!accountId)
-        return;
+        return false;
 
     std::shared_ptr<PlayerbotLoginQueryHolder> holder =
         std::make_shared<PlayerbotLoginQueryHolder>(this, masterAccountId, accountId, playerGuid);
     if (!holder->Initialize())
     {
-        return;
+        return false;
     }
 
     if (WorldSession* masterSession = sWorld->FindSession(masterAccountId))
     {
         masterSession->AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder))
-            .AfterComplete([this](SQLQueryHolderBase const& holder)
-                           { HandlePlayerBotLoginCallback(static_cast<PlayerbotLoginQueryHolder const&>(holder)); });
+            .AfterComplete([this, playerGuid, holder](SQLQueryHolderBase const& /*result*/)
+                           { OnLoginQueryComplete(playerGuid, holder); });
     }
     else
     {
         sWorld->AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder))
-            .AfterComplete([this](SQLQueryHolderBase const& holder)
-                           { HandlePlayerBotLoginCallback(static_cast<PlayerbotLoginQueryHolder const&>(holder)); });
+            .AfterComplete([this, playerGuid, holder](SQLQueryHolderBase const& /*result*/)
+                           { OnLoginQueryComplete(playerGuid, holder); });
     }
+
+    return true;
+}
+
+void PlayerbotHolder::OnLoginQueryComplete(ObjectGuid /*guid*/, std::shared_ptr<PlayerbotLoginQueryHolder> holder)
+{
+    HandlePlayerBotLoginCallback(*holder);
 }
 
 void PlayerbotHolder::HandlePlayerBotLoginCallback(PlayerbotLoginQueryHolder const& holder)
@@ -894,6 +902,10 @@ std::vector<std::string> PlayerbotHolder::HandlePlayerbotCommand(char const* arg
     {
         messages.push_back("Reloading config");
         sPlayerbotAIConfig->Initialize();
+        // some strategies read config while building their triggers
+        sStrategyGraphCache->Clear();
+        // the random bot accounts were loaded again, read their characters again too
+        sRandomPlayerbotMgr->ReloadBotCharacters();
         return messages;
     }
 
@@ -26,7 +26,7 @@ public:
     PlayerbotHolder();
     virtual ~PlayerbotHolder(){};
 
-    void AddPlayerBot(ObjectGuid guid, uint32 masterAccountId);
+    bool AddPlayerBot(ObjectGuid guid, uint32 masterAccountId);
     void HandlePlayerBotLoginCallback(PlayerbotLoginQueryHolder const& holder);
 
     void LogoutPlayerBot(ObjectGuid guid);
@@ -55,6 +55,8 @@ public:
 
 protected:
     virtual void OnBotLoginInternal(Player* const bot) = 0;
+    // Called once the character queries of a bot are done, finishes the login right away
+    virtual void OnLoginQueryComplete(ObjectGuid guid, std::shared_ptr<PlayerbotLoginQueryHolder> holder);
 
     PlayerBotMap playerBots;
 };
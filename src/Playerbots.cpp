@@ -23,7 +23,10 @@
 #include "DatabaseLoader.h"
 #include "GuildTaskMgr.h"
 #include "Metric.h"
+#include "PlayerbotDbStore.h"
+#include "PlayerbotLogWriter.h"
 #include "RandomPlayerbotMgr.h"
+#include "RealPlayerGrid.h"
 #include "ScriptMgr.h"
 #include "cs_playerbots.h"
 
@@ -243,6 +246,14 @@ public:
         LOG_INFO("server.loading", ">> Loaded playerbots config in {} ms", GetMSTimeDiffToNow(oldMSTime));
         LOG_INFO("server.loading", " ");
     }
+
+    void OnShutdown() override
+    {
+        // the async queue may not be drained on shutdown
+        sRandomPlayerbotMgr->FlushEventValues(true);
+        sPlayerbotDbStore->Flush(true);
+        sPlayerbotLogWriter->Stop();
+    }
 };
 
 class PlayerbotsScript : public PlayerbotScript
@@ -303,7 +314,9 @@ public:
 
     void OnPlayerbotUpdate(uint32 diff) override
     {
+        sRealPlayerGrid->Update(sRandomPlayerbotMgr->GetPlayers());
         sRandomPlayerbotMgr->UpdateAI(diff);
+        sRandomPlayerbotMgr->UpdateLogins();
         sRandomPlayerbotMgr->UpdateSessions();
     }
 
@@ -48,5 +48,7 @@ int strcmpi(char const* s1, char const* s2);
     sPlayerbotsMgr->GetPlayerbotAI(player)->GetAiObjectContext()->GetValue<type>(name, param)->Get()
 #define GAI_VALUE(type, name) sSharedValueContext->getGlobalValue<type>(name)->Get()
 #define GAI_VALUE2(type, name, param) sSharedValueContext->getGlobalValue<type>(name, param)->Get()
+#define GAI_SNAPSHOT(type, name) sSharedValueContext->getGlobalSnapshot<type>(name)
+#define GAI_SNAPSHOT2(type, name, param) sSharedValueContext->getGlobalSnapshot<type>(name, param)
 
 #endif
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <boost/thread/thread.hpp>
+#include <chrono>
 #include <cstdlib>
 #include <iomanip>
 #include <random>
@@ -20,6 +21,7 @@
 #include "ChannelMgr.h"
 #include "DatabaseEnv.h"
 #include "Define.h"
+#include "Engine.h"
 #include "FleeManager.h"
 #include "GameTime.h"
 #include "GridNotifiers.h"
@@ -28,9 +30,11 @@
 #include "GuildTaskMgr.h"
 #include "LFGMgr.h"
 #include "MapMgr.h"
+#include "PathCache.h"
 #include "PerformanceMonitor.h"
 #include "PlayerbotAIConfig.h"
 #include "PlayerbotCommandServer.h"
+#include "PlayerbotDbStore.h"
 #include "PlayerbotFactory.h"
 #include "Playerbots.h"
 #include "Random.h"
@@ -40,6 +44,45 @@
 #include "UpdateTime.h"
 #include "World.h"
 
+// Rows per statement when writing pending event values
+#define RANDOM_BOT_EVENT_FLUSH_BATCH 500
+
+// Names of the RandomBotEvent values as stored in playerbots_random_bots
+char const* const RandomBotEventNames[RANDOM_BOT_EVENT_MAX] = {
+    "add",
+    "login",
+    "logout",
+    "update",
+    "randomize",
+    "teleport",
+    "change_strategy",
+    "dead",
+    "revive",
+    "bot_count",
+    "bot_delete",
+    "level",
+    "buymultiplier",
+    "sellmultiplier",
+    "specNo",
+    "specLink",
+    "firstSkill",
+    "secondSkill"};
+
+RandomBotEvent GetRandomBotEvent(std::string const& name)
+{
+    static std::unordered_map<std::string, RandomBotEvent> const events = []()
+    {
+        std::unordered_map<std::string, RandomBotEvent> events;
+        for (uint32 i = 0; i < RANDOM_BOT_EVENT_MAX; ++i)
+            events[RandomBotEventNames[i]] = RandomBotEvent(i);
+
+        return events;
+    }();
+
+    std::unordered_map<std::string, RandomBotEvent>::const_iterator i = events.find(name);
+    return i != events.end() ? i->second : RANDOM_BOT_EVENT_MAX;
+}
+
 void PrintStatsThread() { sRandomPlayerbotMgr->PrintStats(); }
 
 void activatePrintStatsThread()
@@ -153,7 +196,15 @@ double botPIDImpl::calculate(double setpoint, double pv)
 
 botPIDImpl::~botPIDImpl() {}
 
-RandomPlayerbotMgr::RandomPlayerbotMgr() : PlayerbotHolder(), processTicks(0), totalPmo(nullptr)
+RandomPlayerbotMgr::RandomPlayerbotMgr()
+    : PlayerbotHolder(),
+      processTicks(0),
+      eventsLoaded(false),
+      lastEventFlush(time(nullptr)),
+      flushedEvents(0),
+      botCharactersLoaded(false),
+      loginsInFlight(0),
+      totalPmo(nullptr)
 {
     playersLevel = sPlayerbotAIConfig->randombotStartingLevel;
 
@@ -172,7 +223,7 @@ RandomPlayerbotMgr::RandomPlayerbotMgr() : PlayerbotHolder(), processTicks(0), t
 
 RandomPlayerbotMgr::~RandomPlayerbotMgr() {}
 
-uint32 RandomPlayerbotMgr::GetMaxAllowedBotCount() { return GetEventValue(0, "bot_count"); }
+uint32 RandomPlayerbotMgr::GetMaxAllowedBotCount() { return GetEventValue(0, RANDOM_BOT_EVENT_BOT_COUNT); }
 
 void RandomPlayerbotMgr::LogPlayerLocation()
 {
@@ -287,6 +338,12 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
         totalPmo->finish();
 
     totalPmo = sPerformanceMonitor->start(PERF_MON_TOTAL, "RandomPlayerbotMgr::FullTick");
+    sPerformanceMonitor->Update();
+
+    if (time(nullptr) - lastEventFlush >= sPlayerbotAIConfig->randomBotEventFlushInterval)
+        FlushEventValues();
+
+    sPlayerbotDbStore->Update();
 
     if (!sPlayerbotAIConfig->randomBotAutologin || !sPlayerbotAIConfig->enabled)
         return;
@@ -300,12 +357,12 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
         ScaleBotActivity();
     }
 
-    uint32 maxAllowedBotCount = GetEventValue(0, "bot_count");
+    uint32 maxAllowedBotCount = GetEventValue(0, RANDOM_BOT_EVENT_BOT_COUNT);
     if (!maxAllowedBotCount || (maxAllowedBotCount < sPlayerbotAIConfig->minRandomBots ||
                                 maxAllowedBotCount > sPlayerbotAIConfig->maxRandomBots))
     {
         maxAllowedBotCount = urand(sPlayerbotAIConfig->minRandomBots, sPlayerbotAIConfig->maxRandomBots);
-        SetEventValue(0, "bot_count", maxAllowedBotCount,
+        SetEventValue(0, RANDOM_BOT_EVENT_BOT_COUNT, maxAllowedBotCount,
                       urand(sPlayerbotAIConfig->randomBotCountChangeMinInterval,
                             sPlayerbotAIConfig->randomBotCountChangeMaxInterval));
     }
@@ -350,7 +407,8 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
 
     uint32 updateBots = sPlayerbotAIConfig->randomBotsPerInterval * onlineBotFocus / 100;
     uint32 maxNewBots = onlineBotCount < maxAllowedBotCount ? maxAllowedBotCount - onlineBotCount : 0;
-    uint32 loginBots = std::min(sPlayerbotAIConfig->randomBotsPerInterval - updateBots, maxNewBots);
+    // queueing is cheap, UpdateLogins decides how many of them log in per world update
+    uint32 loginBots = maxNewBots > loginPending.size() ? maxNewBots - loginPending.size() : 0;
 
     if (!availableBots.empty())
     {
@@ -371,9 +429,6 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
 
         if (loginBots)
         {
-            loginBots += updateBots;
-            loginBots = std::min(loginBots, maxNewBots);
-
             LOG_INFO("playerbots", "{} new bots", loginBots);
 
             // Log in bots
@@ -422,15 +477,55 @@ void RandomPlayerbotMgr::ScaleBotActivity()
     setActivityPercentage(activityPercentage);
 }
 
+void RandomPlayerbotMgr::LoadBotCharacters()
+{
+    botCharacters.clear();
+    botCharactersLoaded = true;
+
+    if (sPlayerbotAIConfig->randomBotAccounts.empty())
+        return;
+
+    std::ostringstream accounts;
+    for (std::vector<uint32>::iterator i = sPlayerbotAIConfig->randomBotAccounts.begin();
+         i != sPlayerbotAIConfig->randomBotAccounts.end(); ++i)
+    {
+        if (i != sPlayerbotAIConfig->randomBotAccounts.begin())
+            accounts << ",";
+
+        accounts << *i;
+    }
+
+    uint32 count = 0;
+    if (QueryResult result = CharacterDatabase.Query(
+            "SELECT guid, account, class FROM characters WHERE account IN ({})", accounts.str()))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            RandomBotCharacter character;
+            character.guid = fields[0].Get<uint32>();
+            character.cls = fields[2].Get<uint8>();
+            botCharacters[fields[1].Get<uint32>()].push_back(character);
+            ++count;
+        } while (result->NextRow());
+    }
+
+    LOG_INFO("playerbots", "Loaded {} characters of {} random bot accounts", count, botCharacters.size());
+}
+
 uint32 RandomPlayerbotMgr::AddRandomBots()
 {
-    uint32 maxAllowedBotCount = GetEventValue(0, "bot_count");
+    uint32 maxAllowedBotCount = GetEventValue(0, RANDOM_BOT_EVENT_BOT_COUNT);
 
     if (currentBots.size() < maxAllowedBotCount)
     {
+        if (!botCharactersLoaded)
+            LoadBotCharacters();
+
         maxAllowedBotCount -= currentBots.size();
         maxAllowedBotCount = std::min(sPlayerbotAIConfig->randomBotsPerInterval, maxAllowedBotCount);
 
+        std::unordered_set<uint32> current(currentBots.begin(), currentBots.end());
         for (std::vector<uint32>::iterator i = sPlayerbotAIConfig->randomBotAccounts.begin();
              i != sPlayerbotAIConfig->randomBotAccounts.end(); i++)
         {
@@ -442,45 +537,31 @@ uint32 RandomPlayerbotMgr::AddRandomBots()
                 uint32 index = urand(0, limit);
                 accountId = sPlayerbotAIConfig->randomBotAccounts[index];
             }
-            CharacterDatabasePreparedStatement* stmt =
-                CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARS_BY_ACCOUNT_ID);
-            stmt->SetData(0, accountId);
-            PreparedQueryResult result = CharacterDatabase.Query(stmt);
-            if (!result)
+            std::unordered_map<uint32, std::vector<RandomBotCharacter>>::const_iterator characters =
+                botCharacters.find(accountId);
+            if (characters == botCharacters.end())
                 continue;
             std::vector<uint32> guids;
-            do
+            for (RandomBotCharacter const& character : characters->second)
             {
-                Field* fields = result->Fetch();
-                ObjectGuid::LowType guid = fields[0].Get<uint32>();
-                if (GetEventValue(guid, "add"))
+                ObjectGuid::LowType guid = character.guid;
+                if (GetEventValue(guid, RANDOM_BOT_EVENT_ADD))
                     continue;
 
-                if (GetEventValue(guid, "logout"))
+                if (GetEventValue(guid, RANDOM_BOT_EVENT_LOGOUT))
                     continue;
 
                 if (GetPlayerBot(guid))
                     continue;
 
-                if (std::find(currentBots.begin(), currentBots.end(), guid) != currentBots.end())
+                if (current.find(guid) != current.end())
+                    continue;
+
+                if (sPlayerbotAIConfig->disableDeathKnightLogin && character.cls == CLASS_DEATH_KNIGHT)
                     continue;
 
-                if (sPlayerbotAIConfig->disableDeathKnightLogin)
-                {
-                    QueryResult result = CharacterDatabase.Query("Select class from characters where guid = {}", guid);
-                    if (!result)
-                    {
-                        continue;
-                    }
-                    Field* fields = result->Fetch();
-                    uint32 rClass = fields[0].Get<uint32>();
-                    if (rClass == CLASS_DEATH_KNIGHT)
-                    {
-                        continue;
-                    }
-                }
                 guids.push_back(guid);
-            } while (result->NextRow());
+            }
 
             std::mt19937 rnd(time(0));
             std::shuffle(guids.begin(), guids.end(), rnd);
@@ -492,9 +573,10 @@ uint32 RandomPlayerbotMgr::AddRandomBots()
                                               sPlayerbotAIConfig->maxRandomBotInWorldTime)
                                       : sPlayerbotAIConfig->randomBotInWorldWithRotationDisabled;
 
-                SetEventValue(guid, "add", 1, add_time);
-                SetEventValue(guid, "logout", 0, 0);
+                SetEventValue(guid, RANDOM_BOT_EVENT_ADD, 1, add_time);
+                SetEventValue(guid, RANDOM_BOT_EVENT_LOGOUT, 0, 0);
                 currentBots.push_back(guid);
+                current.insert(guid);
 
                 maxAllowedBotCount--;
                 if (!maxAllowedBotCount)
@@ -513,6 +595,70 @@ uint32 RandomPlayerbotMgr::AddRandomBots()
     return currentBots.size();
 }
 
+bool RandomPlayerbotMgr::QueueLogin(uint32 bot)
+{
+    if (!loginPending.insert(bot).second)
+        return false;
+
+    loginQueue.push_back(bot);
+    return true;
+}
+
+void RandomPlayerbotMgr::UpdateLogins()
+{
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    std::chrono::microseconds budget(sPlayerbotAIConfig->randomBotLoginBudget);
+
+    // let the world catch up with its target update time before adding more load
+    if (sPlayerbotAIConfig->randomBotLoginWaitForWorld &&
+        sWorldUpdateTime.GetAverageUpdateTime() >
+            (players.empty() ? sPlayerbotAIConfig->diffEmpty : sPlayerbotAIConfig->diffWithPlayer))
+        return;
+
+    // finish at least one login per update, so a single slow login can't stall the queue
+    while (true)
+    {
+        std::pair<ObjectGuid, std::shared_ptr<PlayerbotLoginQueryHolder>> ready;
+        {
+            std::lock_guard<std::mutex> guard(loginReadyLock);
+            if (loginReady.empty())
+                break;
+
+            ready = std::move(loginReady.front());
+            loginReady.pop_front();
+        }
+
+        if (loginPending.erase(ready.first.GetCounter()))
+            --loginsInFlight;
+
+        HandlePlayerBotLoginCallback(*ready.second);
+
+        if (std::chrono::steady_clock::now() - started >= budget)
+            return;
+    }
+
+    // the database loads the characters while the world keeps updating
+    while (!loginQueue.empty() && loginsInFlight < sPlayerbotAIConfig->randomBotLoginMaxInFlight)
+    {
+        uint32 bot = loginQueue.front();
+        loginQueue.pop_front();
+
+        if (AddPlayerBot(ObjectGuid::Create<HighGuid::Player>(bot), 0))
+            ++loginsInFlight;
+        else
+            loginPending.erase(bot);
+
+        if (std::chrono::steady_clock::now() - started >= budget)
+            return;
+    }
+}
+
+void RandomPlayerbotMgr::OnLoginQueryComplete(ObjectGuid guid, std::shared_ptr<PlayerbotLoginQueryHolder> holder)
+{
+    std::lock_guard<std::mutex> guard(loginReadyLock);
+    loginReady.push_back(std::make_pair(guid, holder));
+}
+
 void RandomPlayerbotMgr::LoadBattleMastersCache()
 {
     BattleMastersCache.clear();
@@ -570,6 +716,9 @@ void RandomPlayerbotMgr::LoadBattleMastersCache()
     } while (result->NextRow());
 
     LOG_INFO("playerbots", ">> Loaded {} battlemaster entries", count);
+
+    // "bg masters" snapshots are built from this cache
+    sSharedValueContext->Rebuild("bg masters");
 }
 
 void RandomPlayerbotMgr::CheckBgQueue()
@@ -965,7 +1114,7 @@ void RandomPlayerbotMgr::CheckPlayers()
 
 void RandomPlayerbotMgr::ScheduleRandomize(uint32 bot, uint32 time)
 {
-    SetEventValue(bot, "randomize", 1, time);
+    SetEventValue(bot, RANDOM_BOT_EVENT_RANDOMIZE, 1, time);
     // SetEventValue(bot, "logout", 1, time + 30 + urand(sPlayerbotAIConfig->randomBotUpdateInterval,
     // sPlayerbotAIConfig->randomBotUpdateInterval * 3));
 }
@@ -975,7 +1124,7 @@ void RandomPlayerbotMgr::ScheduleTeleport(uint32 bot, uint32 time)
     if (!time)
         time = 60 + urand(sPlayerbotAIConfig->randomBotUpdateInterval, sPlayerbotAIConfig->randomBotUpdateInterval * 3);
 
-    SetEventValue(bot, "teleport", 1, time);
+    SetEventValue(bot, RANDOM_BOT_EVENT_TELEPORT, 1, time);
 }
 
 void RandomPlayerbotMgr::ScheduleChangeStrategy(uint32 bot, uint32 time)
@@ -984,7 +1133,7 @@ void RandomPlayerbotMgr::ScheduleChangeStrategy(uint32 bot, uint32 time)
         time = urand(sPlayerbotAIConfig->minRandomBotChangeStrategyTime,
                      sPlayerbotAIConfig->maxRandomBotChangeStrategyTime);
 
-    SetEventValue(bot, "change_strategy", 1, time);
+    SetEventValue(bot, RANDOM_BOT_EVENT_CHANGE_STRATEGY, 1, time);
 }
 
 bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
@@ -994,7 +1143,7 @@ bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
     Player* player = GetPlayerBot(botGUID);
     PlayerbotAI* botAI = player ? GET_PLAYERBOT_AI(player) : nullptr;
 
-    uint32 isValid = GetEventValue(bot, "add");
+    uint32 isValid = GetEventValue(bot, RANDOM_BOT_EVENT_ADD);
     if (!isValid)
     {
         if (!player || !player->GetGroup())
@@ -1005,7 +1154,7 @@ bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
             else
                 LOG_INFO("playerbots", "Bot #{}: log out", bot);
 
-            SetEventValue(bot, "add", 0, 0);
+            SetEventValue(bot, RANDOM_BOT_EVENT_ADD, 0, 0);
             currentBots.erase(std::remove(currentBots.begin(), currentBots.end(), bot), currentBots.end());
 
             if (player)
@@ -1015,27 +1164,29 @@ bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
         return false;
     }
 
-    uint32 isLogginIn = GetEventValue(bot, "login");
+    uint32 isLogginIn = GetEventValue(bot, RANDOM_BOT_EVENT_LOGIN);
     if (isLogginIn)
         return false;
 
     if (!player)
     {
-        AddPlayerBot(botGUID, 0);
-        SetEventValue(bot, "login", 1, sPlayerbotAIConfig->randomBotUpdateInterval);
+        if (!QueueLogin(bot))
+            return false;
+
+        SetEventValue(bot, RANDOM_BOT_EVENT_LOGIN, 1, sPlayerbotAIConfig->randomBotUpdateInterval);
 
         uint32 randomTime =
             urand(sPlayerbotAIConfig->minRandomBotReviveTime, sPlayerbotAIConfig->maxRandomBotReviveTime);
-        SetEventValue(bot, "update", 1, randomTime);
+        SetEventValue(bot, RANDOM_BOT_EVENT_UPDATE, 1, randomTime);
 
         // do not randomize or teleport immediately after server start (prevent lagging)
-        if (!GetEventValue(bot, "randomize"))
+        if (!GetEventValue(bot, RANDOM_BOT_EVENT_RANDOMIZE))
         {
             randomTime = urand(sPlayerbotAIConfig->randomBotUpdateInterval * 5,
                                sPlayerbotAIConfig->randomBotUpdateInterval * 20);
             ScheduleRandomize(bot, randomTime);
         }
-        if (!GetEventValue(bot, "teleport"))
+        if (!GetEventValue(bot, RANDOM_BOT_EVENT_TELEPORT))
         {
             randomTime = urand(sPlayerbotAIConfig->randomBotUpdateInterval * 5,
                                sPlayerbotAIConfig->randomBotUpdateInterval * 20);
@@ -1044,12 +1195,12 @@ bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
         return true;
     }
 
-    SetEventValue(bot, "login", 0, 0);
+    SetEventValue(bot, RANDOM_BOT_EVENT_LOGIN, 0, 0);
 
     if (player->GetGroup() || player->HasUnitState(UNIT_STATE_IN_FLIGHT))
         return false;
 
-    uint32 update = GetEventValue(bot, "update");
+    uint32 update = GetEventValue(bot, RANDOM_BOT_EVENT_UPDATE);
     if (!update)
     {
         if (botAI)
@@ -1080,19 +1231,19 @@ bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
 
         uint32 randomTime =
             urand(sPlayerbotAIConfig->minRandomBotReviveTime, sPlayerbotAIConfig->maxRandomBotReviveTime);
-        SetEventValue(bot, "update", 1, randomTime);
+        SetEventValue(bot, RANDOM_BOT_EVENT_UPDATE, 1, randomTime);
 
         return true;
     }
 
-    uint32 logout = GetEventValue(bot, "logout");
+    uint32 logout = GetEventValue(bot, RANDOM_BOT_EVENT_LOGOUT);
     if (player && !logout && !isValid)
     {
         LOG_INFO("playerbots", "Bot #{} {}:{} <{}>: log out", bot, IsAlliance(player->getRace()) ? "A" : "H",
                  player->GetLevel(), player->GetName().c_str());
         LogoutPlayerBot(botGUID);
         currentBots.remove(bot);
-        SetEventValue(bot, "logout", 1,
+        SetEventValue(bot, RANDOM_BOT_EVENT_LOGOUT, 1,
                       urand(sPlayerbotAIConfig->minRandomBotInWorldTime, sPlayerbotAIConfig->maxRandomBotInWorldTime));
         return true;
     }
@@ -1114,18 +1265,18 @@ bool RandomPlayerbotMgr::ProcessBot(Player* player)
     // return false;
     if (player->isDead())
     {
-        if (!GetEventValue(bot, "dead"))
+        if (!GetEventValue(bot, RANDOM_BOT_EVENT_DEAD))
         {
             uint32 randomTime =
                 urand(sPlayerbotAIConfig->minRandomBotReviveTime, sPlayerbotAIConfig->maxRandomBotReviveTime);
             // LOG_INFO("playerbots", "Mark bot {} as dead, will be revived in {}s.", player->GetName().c_str(),
             // randomTime);
-            SetEventValue(bot, "dead", 1, sPlayerbotAIConfig->maxRandomBotInWorldTime);
-            SetEventValue(bot, "revive", 1, randomTime);
+            SetEventValue(bot, RANDOM_BOT_EVENT_DEAD, 1, sPlayerbotAIConfig->maxRandomBotInWorldTime);
+            SetEventValue(bot, RANDOM_BOT_EVENT_REVIVE, 1, randomTime);
             return false;
         }
 
-        if (!GetEventValue(bot, "revive"))
+        if (!GetEventValue(bot, RANDOM_BOT_EVENT_REVIVE))
         {
             Revive(player);
             return true;
@@ -1162,7 +1313,7 @@ bool RandomPlayerbotMgr::ProcessBot(Player* player)
     //     }
     // }
 
-    uint32 randomize = GetEventValue(bot, "randomize");
+    uint32 randomize = GetEventValue(bot, RANDOM_BOT_EVENT_RANDOMIZE);
     if (!randomize)
     {
         Randomize(player);
@@ -1177,7 +1328,7 @@ bool RandomPlayerbotMgr::ProcessBot(Player* player)
     // enable random teleport logic if no auto traveling enabled
     // if (!sPlayerbotAIConfig->autoDoQuests)
     // {
-    uint32 teleport = GetEventValue(bot, "teleport");
+    uint32 teleport = GetEventValue(bot, RANDOM_BOT_EVENT_TELEPORT);
     if (!teleport)
     {
         LOG_INFO("playerbots", "Bot #{} <{}>: teleport for level and refresh", bot, player->GetName());
@@ -1206,8 +1357,8 @@ void RandomPlayerbotMgr::Revive(Player* player)
     uint32 bot = player->GetGUID().GetCounter();
 
     // LOG_INFO("playerbots", "Bot {} revived", player->GetName().c_str());
-    SetEventValue(bot, "dead", 0, 0);
-    SetEventValue(bot, "revive", 0, 0);
+    SetEventValue(bot, RANDOM_BOT_EVENT_DEAD, 0, 0);
+    SetEventValue(bot, RANDOM_BOT_EVENT_REVIVE, 0, 0);
 
     Refresh(player);
     RandomTeleportGrindForLevel(player);
@@ -1688,17 +1839,8 @@ void RandomPlayerbotMgr::RandomizeFirst(Player* bot)
     uint32 inworldTime =
         urand(sPlayerbotAIConfig->minRandomBotInWorldTime, sPlayerbotAIConfig->maxRandomBotInWorldTime);
 
-    PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_UPD_RANDOM_BOTS);
-    stmt->SetData(0, randomTime);
-    stmt->SetData(1, "bot_delete");
-    stmt->SetData(2, bot->GetGUID().GetCounter());
-    PlayerbotsDatabase.Execute(stmt);
-
-    stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_UPD_RANDOM_BOTS);
-    stmt->SetData(0, inworldTime);
-    stmt->SetData(1, "logout");
-    stmt->SetData(2, bot->GetGUID().GetCounter());
-    PlayerbotsDatabase.Execute(stmt);
+    SetEventValidIn(bot->GetGUID().GetCounter(), RANDOM_BOT_EVENT_BOT_DELETE, randomTime);
+    SetEventValidIn(bot->GetGUID().GetCounter(), RANDOM_BOT_EVENT_LOGOUT, inworldTime);
 
     // teleport to a random inn for bot level
     if (GET_PLAYERBOT_AI(bot))
@@ -1729,17 +1871,8 @@ void RandomPlayerbotMgr::RandomizeMin(Player* bot)
     uint32 inworldTime =
         urand(sPlayerbotAIConfig->minRandomBotInWorldTime, sPlayerbotAIConfig->maxRandomBotInWorldTime);
 
-    PlayerbotsDatabasePreparedStatement* stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_UPD_RANDOM_BOTS);
-    stmt->SetData(0, randomTime);
-    stmt->SetData(1, "bot_delete");
-    stmt->SetData(2, bot->GetGUID().GetCounter());
-    PlayerbotsDatabase.Execute(stmt);
-
-    stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_UPD_RANDOM_BOTS);
-    stmt->SetData(0, inworldTime);
-    stmt->SetData(1, "logout");
-    stmt->SetData(2, bot->GetGUID().GetCounter());
-    PlayerbotsDatabase.Execute(stmt);
+    SetEventValidIn(bot->GetGUID().GetCounter(), RANDOM_BOT_EVENT_BOT_DELETE, randomTime);
+    SetEventValidIn(bot->GetGUID().GetCounter(), RANDOM_BOT_EVENT_LOGOUT, inworldTime);
 
     // teleport to a random inn for bot level
     if (GET_PLAYERBOT_AI(bot))
@@ -1864,19 +1997,18 @@ void RandomPlayerbotMgr::GetBots()
     if (!currentBots.empty())
         return;
 
-    PlayerbotsDatabasePreparedStatement* stmt =
-        PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_RANDOM_BOTS_BY_OWNER_AND_EVENT);
-    stmt->SetData(0, 0);
-    stmt->SetData(1, "add");
-    if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
+    LoadEventCache();
+
+    std::vector<uint32> bots;
     {
-        do
-        {
-            Field* fields = result->Fetch();
-            uint32 bot = fields[0].Get<uint32>();
-            if (GetEventValue(bot, "add"))
-                currentBots.push_back(bot);
-        } while (result->NextRow());
+        std::shared_lock<std::shared_mutex> guard(eventLock);
+        bots = eventBots;
+    }
+
+    for (uint32 bot : bots)
+    {
+        if (GetEventValue(bot, RANDOM_BOT_EVENT_ADD))
+            currentBots.push_back(bot);
     }
 }
 
@@ -1886,121 +2018,293 @@ std::vector<uint32> RandomPlayerbotMgr::GetBgBots(uint32 bracket)
 
     std::vector<uint32> BgBots;
 
-    PlayerbotsDatabasePreparedStatement* stmt =
-        PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_RANDOM_BOTS_BY_EVENT_AND_VALUE);
-    stmt->SetData(0, "bg");
-    stmt->SetData(1, bracket);
-    if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
+    // the event cache holds every row of the table plus the writes not flushed yet,
+    // rows with a zero value are deleted on flush so they never matched the query
+    LoadEventCache();
+
+    std::shared_lock<std::shared_mutex> guard(eventLock);
+    for (std::map<uint32, std::map<std::string, CachedEvent>>::const_iterator i = customEvents.begin();
+         i != customEvents.end(); ++i)
+    {
+        std::map<std::string, CachedEvent>::const_iterator e = i->second.find("bg");
+        if (e != i->second.end() && e->second.value && e->second.value == bracket)
+            BgBots.push_back(i->first);
+    }
+
+    return BgBots;
+}
+
+void RandomPlayerbotMgr::LoadEventCache()
+{
+    if (eventsLoaded)
+        return;
+
+    std::unique_lock<std::shared_mutex> guard(eventLock);
+    if (eventsLoaded)
+        return;
+
+    // later rows win, as they did when rows were read per bot
+    uint32 count = 0;
+    if (QueryResult result = PlayerbotsDatabase.Query(
+            "SELECT bot, event, `value`, `time`, validIn, `data` FROM playerbots_random_bots WHERE owner = 0 "
+            "ORDER BY id"))
     {
         do
         {
             Field* fields = result->Fetch();
-            uint32 bot = fields[0].Get<uint32>();
-            BgBots.push_back(bot);
+            CachedEvent e(fields[2].Get<uint32>(), fields[3].Get<uint32>(), fields[4].Get<uint32>(),
+                          fields[5].Get<std::string>());
+            StoreEvent(fields[0].Get<uint32>(), fields[1].Get<std::string>(), e);
+            ++count;
         } while (result->NextRow());
     }
 
-    return std::move(BgBots);
+    LOG_INFO("playerbots", "Loaded {} random bot events for {} bots", count, eventBots.size());
+
+    eventsLoaded = true;
 }
 
-uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, std::string const event)
+void RandomPlayerbotMgr::StoreEvent(uint32 bot, std::string const& event, CachedEvent const& e)
 {
-    // load all events at once on first event load
-    if (eventCache[bot].empty())
+    RandomBotEvent kind = GetRandomBotEvent(event);
+    if (kind == RANDOM_BOT_EVENT_MAX)
     {
-        PlayerbotsDatabasePreparedStatement* stmt =
-            PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_SEL_RANDOM_BOTS_BY_OWNER_AND_BOT);
-        stmt->SetData(0, 0);
-        stmt->SetData(1, bot);
-        if (PreparedQueryResult result = PlayerbotsDatabase.Query(stmt))
-        {
-            do
-            {
-                Field* fields = result->Fetch();
-                std::string const eventName = fields[0].Get<std::string>();
-
-                CachedEvent e;
-                e.value = fields[1].Get<uint32>();
-                e.lastChangeTime = fields[2].Get<uint32>();
-                e.validIn = fields[3].Get<uint32>();
-                e.data = fields[4].Get<std::string>();
-                eventCache[bot][eventName] = std::move(e);
-            } while (result->NextRow());
-        }
+        customEvents[bot][event] = e;
+        return;
     }
 
-    CachedEvent& e = eventCache[bot][event];
-    /*if (e.IsEmpty())
+    std::pair<std::unordered_map<uint32, uint32>::iterator, bool> inserted =
+        eventBotIndex.insert(std::make_pair(bot, eventBots.size()));
+    if (inserted.second)
     {
-        QueryResult results = PlayerbotsDatabase.Query("SELECT `value`, `time`, validIn, `data` FROM
-    playerbots_random_bots WHERE owner = 0 AND bot = {} AND event = {}", bot, event.c_str());
-
-        if (results)
-        {
-            Field* fields = results->Fetch();
-            e.value = fields[0].Get<uint32>();
-            e.lastChangeTime = fields[1].Get<uint32>();
-            e.validIn = fields[2].Get<uint32>();
-            e.data = fields[3].Get<std::string>();
-        }
+        eventBots.push_back(bot);
+        eventValues.resize(eventBots.size() * RANDOM_BOT_EVENT_MAX);
     }
-    */
 
-    if ((time(0) - e.lastChangeTime) >= e.validIn && event != "specNo" && event != "specLink")
-        e.value = 0;
+    uint32 index = inserted.first->second;
+    RandomBotEventValue& value = eventValues[index * RANDOM_BOT_EVENT_MAX + kind];
+    value.value = e.value;
+    value.lastChangeTime = e.lastChangeTime;
+    value.validIn = e.validIn;
+
+    uint64 dataKey = uint64(index) * RANDOM_BOT_EVENT_MAX + kind;
+    if (e.data.empty())
+        eventData.erase(dataKey);
+    else
+        eventData[dataKey] = e.data;
+}
+
+uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, RandomBotEvent event)
+{
+    LoadEventCache();
+
+    std::shared_lock<std::shared_mutex> guard(eventLock);
+    std::unordered_map<uint32, uint32>::const_iterator i = eventBotIndex.find(bot);
+    if (i == eventBotIndex.end())
+        return 0;
+
+    RandomBotEventValue const& e = eventValues[i->second * RANDOM_BOT_EVENT_MAX + event];
+    if ((time(0) - e.lastChangeTime) >= e.validIn && event != RANDOM_BOT_EVENT_SPEC_NO &&
+        event != RANDOM_BOT_EVENT_SPEC_LINK)
+        return 0;
 
     return e.value;
 }
 
+uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, std::string const event)
+{
+    RandomBotEvent kind = GetRandomBotEvent(event);
+    if (kind != RANDOM_BOT_EVENT_MAX)
+        return GetEventValue(bot, kind);
+
+    LoadEventCache();
+
+    std::shared_lock<std::shared_mutex> guard(eventLock);
+    std::map<uint32, std::map<std::string, CachedEvent>>::const_iterator events = customEvents.find(bot);
+    if (events == customEvents.end())
+        return 0;
+
+    std::map<std::string, CachedEvent>::const_iterator i = events->second.find(event);
+    if (i == events->second.end() || (time(0) - i->second.lastChangeTime) >= i->second.validIn)
+        return 0;
+
+    return i->second.value;
+}
+
 std::string const RandomPlayerbotMgr::GetEventData(uint32 bot, std::string const event)
 {
     std::string data = "";
-    if (GetEventValue(bot, event))
+    if (!GetEventValue(bot, event))
+        return data;
+
+    std::shared_lock<std::shared_mutex> guard(eventLock);
+
+    RandomBotEvent kind = GetRandomBotEvent(event);
+    if (kind == RANDOM_BOT_EVENT_MAX)
     {
-        CachedEvent e = eventCache[bot][event];
-        data = e.data;
+        std::map<uint32, std::map<std::string, CachedEvent>>::const_iterator events = customEvents.find(bot);
+        if (events != customEvents.end())
+        {
+            std::map<std::string, CachedEvent>::const_iterator i = events->second.find(event);
+            if (i != events->second.end())
+                data = i->second.data;
+        }
+
+        return data;
     }
 
+    std::unordered_map<uint32, uint32>::const_iterator i = eventBotIndex.find(bot);
+    if (i == eventBotIndex.end())
+        return data;
+
+    std::unordered_map<uint64, std::string>::const_iterator e =
+        eventData.find(uint64(i->second) * RANDOM_BOT_EVENT_MAX + kind);
+    if (e != eventData.end())
+        data = e->second;
+
     return data;
 }
 
+uint32 RandomPlayerbotMgr::SetEventValue(uint32 bot, RandomBotEvent event, uint32 value, uint32 validIn,
+                                         std::string const data)
+{
+    return SetEventValue(bot, RandomBotEventNames[event], value, validIn, data);
+}
+
 uint32 RandomPlayerbotMgr::SetEventValue(uint32 bot, std::string const event, uint32 value, uint32 validIn,
                                          std::string const data)
 {
+    LoadEventCache();
+
+    CachedEvent e(value, (uint32)time(nullptr), validIn, data);
+    {
+        std::unique_lock<std::shared_mutex> guard(eventLock);
+        StoreEvent(bot, event, e);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(pendingEventsLock);
+        CachedEvent& pending = pendingEvents[std::make_pair(bot, event)];
+        pending = e;
+        pending.lastChangeTime = static_cast<uint32>(GameTime::GetGameTime().count());
+    }
+
+    if (!sPlayerbotAIConfig->randomBotEventFlushInterval)
+        FlushEventValues();
+
+    return value;
+}
+
+void RandomPlayerbotMgr::SetEventValidIn(uint32 bot, RandomBotEvent event, uint32 validIn)
+{
+    LoadEventCache();
+
+    // like the UPDATE it replaces: only an existing event gets a new validIn, value and time are kept
+    CachedEvent e;
+    {
+        std::unique_lock<std::shared_mutex> guard(eventLock);
+        std::unordered_map<uint32, uint32>::const_iterator i = eventBotIndex.find(bot);
+        if (i == eventBotIndex.end())
+            return;
+
+        RandomBotEventValue& value = eventValues[i->second * RANDOM_BOT_EVENT_MAX + event];
+        if (!value.value)
+            return;
+
+        value.validIn = validIn;
+        e = CachedEvent(value.value, value.lastChangeTime, validIn);
+
+        std::unordered_map<uint64, std::string>::const_iterator data =
+            eventData.find(uint64(i->second) * RANDOM_BOT_EVENT_MAX + event);
+        if (data != eventData.end())
+            e.data = data->second;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(pendingEventsLock);
+        std::pair<std::map<std::pair<uint32, std::string>, CachedEvent>::iterator, bool> pending =
+            pendingEvents.insert(std::make_pair(std::make_pair(bot, std::string(RandomBotEventNames[event])), e));
+        if (!pending.second)
+            pending.first->second.validIn = validIn;
+    }
+
+    if (!sPlayerbotAIConfig->randomBotEventFlushInterval)
+        FlushEventValues();
+}
+
+void RandomPlayerbotMgr::FlushEventValues(bool direct)
+{
+    std::map<std::pair<uint32, std::string>, CachedEvent> events;
+    {
+        std::lock_guard<std::mutex> guard(pendingEventsLock);
+        lastEventFlush = time(nullptr);
+        if (pendingEvents.empty())
+            return;
+
+        events.swap(pendingEvents);
+        flushedEvents += events.size();
+    }
+
     PlayerbotsDatabaseTransaction trans = PlayerbotsDatabase.BeginTransaction();
 
-    PlayerbotsDatabasePreparedStatement* stmt =
-        PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_RANDOM_BOTS_BY_OWNER_AND_EVENT);
-    stmt->SetData(0, 0);
-    stmt->SetData(1, bot);
-    stmt->SetData(2, event.c_str());
-    trans->Append(stmt);
-
-    if (value)
-    {
-        stmt = PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_INS_RANDOM_BOTS);
-        stmt->SetData(0, 0);
-        stmt->SetData(1, bot);
-        stmt->SetData(2, static_cast<uint32>(GameTime::GetGameTime().count()));
-        stmt->SetData(3, validIn);
-        stmt->SetData(4, event.c_str());
-        stmt->SetData(5, value);
-        if (data != "")
+    // Rows are removed and reinserted in batches, the table has no unique key to upsert on.
+    std::ostringstream deletes, inserts;
+    uint32 deleteRows = 0, insertRows = 0;
+    for (auto& i : events)
+    {
+        std::string event = i.first.second;
+        PlayerbotsDatabase.EscapeString(event);
+
+        deletes << (deleteRows ? "," : "DELETE FROM playerbots_random_bots WHERE owner = 0 AND (bot, event) IN (")
+                << "(" << i.first.first << ",'" << event << "')";
+
+        if (++deleteRows == RANDOM_BOT_EVENT_FLUSH_BATCH)
         {
-            stmt->SetData(6, data.c_str());
+            deletes << ")";
+            trans->Append(deletes.str().c_str());
+            deletes.str("");
+            deleteRows = 0;
         }
-        else
+    }
+
+    if (deleteRows)
+    {
+        deletes << ")";
+        trans->Append(deletes.str().c_str());
+    }
+
+    for (auto& i : events)
+    {
+        CachedEvent& e = i.second;
+        if (!e.value)
+            continue;
+
+        std::string event = i.first.second;
+        std::string data = e.data;
+        PlayerbotsDatabase.EscapeString(event);
+        PlayerbotsDatabase.EscapeString(data);
+
+        inserts << (insertRows ? ","
+                               : "INSERT INTO playerbots_random_bots (owner, bot, `time`, validIn, event, `value`, "
+                                 "`data`) VALUES ")
+                << "(0," << i.first.first << "," << e.lastChangeTime << "," << e.validIn << ",'" << event << "',"
+                << e.value << "," << (data.empty() ? "NULL" : "'" + data + "'") << ")";
+
+        if (++insertRows == RANDOM_BOT_EVENT_FLUSH_BATCH)
         {
-            stmt->SetData(6);
+            trans->Append(inserts.str().c_str());
+            inserts.str("");
+            insertRows = 0;
         }
-        trans->Append(stmt);
     }
 
-    PlayerbotsDatabase.CommitTransaction(trans);
+    if (insertRows)
+        trans->Append(inserts.str().c_str());
 
-    CachedEvent e(value, (uint32)time(nullptr), validIn, data);
-    eventCache[bot][event] = std::move(e);
-    return value;
+    if (direct)
+        PlayerbotsDatabase.DirectCommitTransaction(trans);
+    else
+        PlayerbotsDatabase.CommitTransaction(trans);
 }
 
 uint32 RandomPlayerbotMgr::GetValue(uint32 bot, std::string const type) { return GetEventValue(bot, type); }
@@ -2040,8 +2344,23 @@ bool RandomPlayerbotMgr::HandlePlayerbotConsoleCommand(ChatHandler* handler, cha
 
     if (cmd == "reset")
     {
+        {
+            std::lock_guard<std::mutex> guard(sRandomPlayerbotMgr->pendingEventsLock);
+            sRandomPlayerbotMgr->pendingEvents.clear();
+        }
+
         PlayerbotsDatabase.Execute(PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_RANDOM_BOTS));
-        sRandomPlayerbotMgr->eventCache.clear();
+
+        {
+            std::unique_lock<std::shared_mutex> guard(sRandomPlayerbotMgr->eventLock);
+            sRandomPlayerbotMgr->eventBotIndex.clear();
+            sRandomPlayerbotMgr->eventBots.clear();
+            sRandomPlayerbotMgr->eventValues.clear();
+            sRandomPlayerbotMgr->eventData.clear();
+            sRandomPlayerbotMgr->customEvents.clear();
+            sRandomPlayerbotMgr->eventsLoaded = true;
+        }
+
         LOG_INFO("playerbots", "Random bots were reset for all players. Please restart the Server.");
         return true;
     }
@@ -2055,6 +2374,7 @@ bool RandomPlayerbotMgr::HandlePlayerbotConsoleCommand(ChatHandler* handler, cha
     if (cmd == "reload")
     {
         sPlayerbotAIConfig->Initialize();
+        ReloadBotCharacters();
         return true;
     }
 
@@ -2275,7 +2595,7 @@ void RandomPlayerbotMgr::OnPlayerLogin(Player* player)
     if (IsRandomBot(player))
     {
         ObjectGuid::LowType guid = player->GetGUID().GetCounter();
-        SetEventValue(guid, "login", 0, 0);
+        SetEventValue(guid, RANDOM_BOT_EVENT_LOGIN, 0, 0);
     }
     else
     {
@@ -2286,7 +2606,7 @@ void RandomPlayerbotMgr::OnPlayerLogin(Player* player)
 
 void RandomPlayerbotMgr::OnPlayerLoginError(uint32 bot)
 {
-    SetEventValue(bot, "add", 0, 0);
+    SetEventValue(bot, RANDOM_BOT_EVENT_ADD, 0, 0);
     currentBots.erase(std::remove(currentBots.begin(), currentBots.end(), bot), currentBots.end());
 }
 
@@ -2357,13 +2677,13 @@ void RandomPlayerbotMgr::PrintStats()
             ++update;
 
         uint32 botId = bot->GetGUID().GetCounter();
-        if (!GetEventValue(botId, "randomize"))
+        if (!GetEventValue(botId, RANDOM_BOT_EVENT_RANDOMIZE))
             ++randomize;
 
-        if (!GetEventValue(botId, "teleport"))
+        if (!GetEventValue(botId, RANDOM_BOT_EVENT_TELEPORT))
             ++teleport;
 
-        if (!GetEventValue(botId, "change_strategy"))
+        if (!GetEventValue(botId, RANDOM_BOT_EVENT_CHANGE_STRATEGY))
             ++changeStrategy;
 
         if (bot->isDead())
@@ -2479,6 +2799,40 @@ void RandomPlayerbotMgr::PrintStats()
     LOG_INFO("playerbots", "Bots role:");
     LOG_INFO("playerbots", "    tank: {}, heal: {}, dps: {}", tank, heal, dps);
 
+    {
+        std::lock_guard<std::mutex> guard(pendingEventsLock);
+        LOG_INFO("playerbots", "Bots events:");
+        LOG_INFO("playerbots", "    Pending writes: {}, flushed: {}", pendingEvents.size(), flushedEvents);
+    }
+
+    LOG_INFO("playerbots", "Bots login:");
+    LOG_INFO("playerbots", "    Queued: {}, waiting for database: {}", loginQueue.size(), loginsInFlight);
+
+    if (uint64 ticks = Engine::triggerTicks.load(std::memory_order_relaxed))
+    {
+        LOG_INFO("playerbots", "Triggers per engine tick:");
+        LOG_INFO("playerbots", "    Checked: {:.1f}, skipped: {:.1f}",
+                 double(Engine::triggerChecks.load(std::memory_order_relaxed)) / ticks,
+                 double(Engine::triggerChecksAvoided.load(std::memory_order_relaxed)) / ticks);
+    }
+
+    uint64 pathHits = sPathCache->hits.load(std::memory_order_relaxed);
+    uint64 pathMisses = sPathCache->misses.load(std::memory_order_relaxed);
+    if (pathHits + pathMisses)
+    {
+        LOG_INFO("playerbots", "Path cache:");
+        LOG_INFO("playerbots", "    Hits: {}, misses: {} ({:.1f}% reused)", pathHits, pathMisses,
+                 100.0 * pathHits / (pathHits + pathMisses));
+    }
+
+    if (uint64 castChecks = PlayerbotAI::castChecks.load(std::memory_order_relaxed))
+    {
+        uint64 castChecksCached = PlayerbotAI::castChecksCached.load(std::memory_order_relaxed);
+        LOG_INFO("playerbots", "Spell cast checks:");
+        LOG_INFO("playerbots", "    Checked: {}, reused: {} ({:.1f}%)", castChecks, castChecksCached,
+                 100.0 * castChecksCached / castChecks);
+    }
+
     LOG_INFO("playerbots", "Bots status:");
     LOG_INFO("playerbots", "    Active: {}", active);
     LOG_INFO("playerbots", "    Moving: {}", moving);
@@ -2521,13 +2875,13 @@ void RandomPlayerbotMgr::PrintStats()
 double RandomPlayerbotMgr::GetBuyMultiplier(Player* bot)
 {
     uint32 id = bot->GetGUID().GetCounter();
-    uint32 value = GetEventValue(id, "buymultiplier");
+    uint32 value = GetEventValue(id, RANDOM_BOT_EVENT_BUY_MULTIPLIER);
     if (!value)
     {
         value = urand(50, 120);
         uint32 validIn = urand(sPlayerbotAIConfig->minRandomBotsPriceChangeInterval,
                                sPlayerbotAIConfig->maxRandomBotsPriceChangeInterval);
-        SetEventValue(id, "buymultiplier", value, validIn);
+        SetEventValue(id, RANDOM_BOT_EVENT_BUY_MULTIPLIER, value, validIn);
     }
 
     return (double)value / 100.0;
@@ -2536,13 +2890,13 @@ double RandomPlayerbotMgr::GetBuyMultiplier(Player* bot)
 double RandomPlayerbotMgr::GetSellMultiplier(Player* bot)
 {
     uint32 id = bot->GetGUID().GetCounter();
-    uint32 value = GetEventValue(id, "sellmultiplier");
+    uint32 value = GetEventValue(id, RANDOM_BOT_EVENT_SELL_MULTIPLIER);
     if (!value)
     {
         value = urand(80, 250);
         uint32 validIn = urand(sPlayerbotAIConfig->minRandomBotsPriceChangeInterval,
                                sPlayerbotAIConfig->maxRandomBotsPriceChangeInterval);
-        SetEventValue(id, "sellmultiplier", value, validIn);
+        SetEventValue(id, RANDOM_BOT_EVENT_SELL_MULTIPLIER, value, validIn);
     }
 
     return (double)value / 100.0;
@@ -2623,7 +2977,7 @@ void RandomPlayerbotMgr::ChangeStrategy(Player* player)
         LOG_INFO("playerbots", "Changing strategy for bot #{} <{}> to RPG", bot, player->GetName().c_str());
         LOG_INFO("playerbots", "Bot #{} <{}>: sent to inn", bot, player->GetName().c_str());
         RandomTeleportForLevel(player);
-        SetEventValue(bot, "teleport", 1, sPlayerbotAIConfig->maxRandomBotInWorldTime);
+        SetEventValue(bot, RANDOM_BOT_EVENT_TELEPORT, 1, sPlayerbotAIConfig->maxRandomBotInWorldTime);
     }
 
     ScheduleChangeStrategy(bot);
@@ -2659,13 +3013,32 @@ void RandomPlayerbotMgr::Remove(Player* bot)
 {
     ObjectGuid owner = bot->GetGUID();
 
+    {
+        std::lock_guard<std::mutex> guard(pendingEventsLock);
+        pendingEvents.erase(pendingEvents.lower_bound(std::make_pair(owner.GetCounter(), std::string())),
+                            pendingEvents.lower_bound(std::make_pair(owner.GetCounter() + 1, std::string())));
+    }
+
     PlayerbotsDatabasePreparedStatement* stmt =
         PlayerbotsDatabase.GetPreparedStatement(PLAYERBOTS_DEL_RANDOM_BOTS_BY_OWNER);
     stmt->SetData(0, 0);
     stmt->SetData(1, owner.GetCounter());
     PlayerbotsDatabase.Execute(stmt);
 
-    eventCache[owner.GetCounter()].clear();
+    {
+        std::unique_lock<std::shared_mutex> guard(eventLock);
+        std::unordered_map<uint32, uint32>::const_iterator i = eventBotIndex.find(owner.GetCounter());
+        if (i != eventBotIndex.end())
+        {
+            for (uint32 event = 0; event < RANDOM_BOT_EVENT_MAX; ++event)
+            {
+                eventValues[i->second * RANDOM_BOT_EVENT_MAX + event] = RandomBotEventValue();
+                eventData.erase(uint64(i->second) * RANDOM_BOT_EVENT_MAX + event);
+            }
+        }
+
+        customEvents.erase(owner.GetCounter());
+    }
 
     LogoutPlayerBot(owner);
 }
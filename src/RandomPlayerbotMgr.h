@@ -6,6 +6,12 @@
 #ifndef _PLAYERBOT_RANDOMPLAYERBOTMGR_H
 #define _PLAYERBOT_RANDOMPLAYERBOTMGR_H
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
 #include "PlayerbotMgr.h"
 
 struct BattlegroundInfo
@@ -65,6 +71,43 @@ public:
     std::string data;
 };
 
+// Events the random bot manager keeps in compact storage, any other name goes to a per bot map
+enum RandomBotEvent
+{
+    RANDOM_BOT_EVENT_ADD = 0,
+    RANDOM_BOT_EVENT_LOGIN,
+    RANDOM_BOT_EVENT_LOGOUT,
+    RANDOM_BOT_EVENT_UPDATE,
+    RANDOM_BOT_EVENT_RANDOMIZE,
+    RANDOM_BOT_EVENT_TELEPORT,
+    RANDOM_BOT_EVENT_CHANGE_STRATEGY,
+    RANDOM_BOT_EVENT_DEAD,
+    RANDOM_BOT_EVENT_REVIVE,
+    RANDOM_BOT_EVENT_BOT_COUNT,
+    RANDOM_BOT_EVENT_BOT_DELETE,
+    RANDOM_BOT_EVENT_LEVEL,
+    RANDOM_BOT_EVENT_BUY_MULTIPLIER,
+    RANDOM_BOT_EVENT_SELL_MULTIPLIER,
+    RANDOM_BOT_EVENT_SPEC_NO,
+    RANDOM_BOT_EVENT_SPEC_LINK,
+    RANDOM_BOT_EVENT_FIRST_SKILL,
+    RANDOM_BOT_EVENT_SECOND_SKILL,
+    RANDOM_BOT_EVENT_MAX
+};
+
+struct RandomBotEventValue
+{
+    uint32 value = 0;
+    uint32 lastChangeTime = 0;
+    uint32 validIn = 0;
+};
+
+struct RandomBotCharacter
+{
+    uint32 guid;
+    uint8 cls;
+};
+
 // https://gist.github.com/bradley219/5373998
 
 class botPIDImpl;
@@ -101,6 +144,8 @@ public:
 
     void LogPlayerLocation();
     void UpdateAIInternal(uint32 elapsed, bool minimal = false) override;
+    // Finishes logins whose queries are done and starts new ones, within the login budget of one world update
+    void UpdateLogins();
 
 private:
     void ScaleBotActivity();
@@ -123,7 +168,7 @@ public:
     void OnPlayerLogin(Player* player);
     void OnPlayerLoginError(uint32 bot);
     Player* GetRandomPlayer();
-    std::vector<Player*> GetPlayers() { return players; };
+    std::vector<Player*> const& GetPlayers() { return players; };
     PlayerBotMap GetAllBots() { return playerBots; };
     void PrintStats();
     double GetBuyMultiplier(Player* bot);
@@ -146,6 +191,9 @@ public:
     void SetValue(uint32 bot, std::string const type, uint32 value, std::string const data = "");
     void SetValue(Player* bot, std::string const type, uint32 value, std::string const data = "");
     void Remove(Player* bot);
+    // Writes the event values changed since the last flush in one transaction, synchronously when direct.
+    void FlushEventValues(bool direct = false);
+    void ReloadBotCharacters() { botCharactersLoaded = false; }
     ObjectGuid const GetBattleMasterGUID(Player* bot, BattlegroundTypeId bgTypeId);
     CreatureData const* GetCreatureDataByEntry(uint32 entry);
     void LoadBattleMastersCache();
@@ -169,21 +217,30 @@ public:
 
 protected:
     void OnBotLoginInternal(Player* const bot) override;
+    void OnLoginQueryComplete(ObjectGuid guid, std::shared_ptr<PlayerbotLoginQueryHolder> holder) override;
 
 private:
     // pid values are set in constructor
     botPID pid = botPID(1, 50, -50, 0, 0, 0);
     float activityMod = 0.25;
+    void LoadEventCache();
+    void StoreEvent(uint32 bot, std::string const& event, CachedEvent const& e);
+    uint32 GetEventValue(uint32 bot, RandomBotEvent event);
     uint32 GetEventValue(uint32 bot, std::string const event);
     std::string const GetEventData(uint32 bot, std::string const event);
+    uint32 SetEventValue(uint32 bot, RandomBotEvent event, uint32 value, uint32 validIn,
+                         std::string const data = "");
     uint32 SetEventValue(uint32 bot, std::string const event, uint32 value, uint32 validIn,
                          std::string const data = "");
+    void SetEventValidIn(uint32 bot, RandomBotEvent event, uint32 validIn);
     void GetBots();
     std::vector<uint32> GetBgBots(uint32 bracket);
     time_t BgCheckTimer;
     time_t LfgCheckTimer;
     time_t PlayersCheckTimer;
+    void LoadBotCharacters();
     uint32 AddRandomBots();
+    bool QueueLogin(uint32 bot);
     bool ProcessBot(uint32 bot);
     void ScheduleRandomize(uint32 bot, uint32 time);
     void RandomTeleport(Player* bot);
@@ -200,8 +257,31 @@ private:
     // std::map<uint32, std::vector<WorldLocation>> rpgLocsCache;
     std::map<uint32, std::map<uint32, std::vector<WorldLocation>>> rpgLocsCacheLevel;
     std::map<TeamId, std::map<BattlegroundTypeId, std::vector<uint32>>> BattleMastersCache;
-    std::map<uint32, std::map<std::string, CachedEvent>> eventCache;
+    // Known events of every bot, RANDOM_BOT_EVENT_MAX values per bot in the order bots were first seen
+    std::unordered_map<uint32, uint32> eventBotIndex;
+    std::vector<uint32> eventBots;
+    std::vector<RandomBotEventValue> eventValues;
+    std::unordered_map<uint64, std::string> eventData;
+    // Events without a RandomBotEvent, by name
+    std::map<uint32, std::map<std::string, CachedEvent>> customEvents;
+    std::atomic<bool> eventsLoaded;
+    std::shared_mutex eventLock;
+    // Event values not written to the database yet, one per bot and event.
+    std::map<std::pair<uint32, std::string>, CachedEvent> pendingEvents;
+    std::mutex pendingEventsLock;
+    time_t lastEventFlush;
+    uint64 flushedEvents;
     std::list<uint32> currentBots;
+    // Characters of the random bot accounts, by account
+    std::unordered_map<uint32, std::vector<RandomBotCharacter>> botCharacters;
+    bool botCharactersLoaded;
+    // Bots waiting for their login queries to be started, and all bots queued or in flight
+    std::deque<uint32> loginQueue;
+    std::unordered_set<uint32> loginPending;
+    uint32 loginsInFlight;
+    // Logins whose queries are done, completed by UpdateLogins
+    std::deque<std::pair<ObjectGuid, std::shared_ptr<PlayerbotLoginQueryHolder>>> loginReady;
+    std::mutex loginReadyLock;
     uint32 bgBotsCount;
     uint32 playersLevel;
     PerformanceMonitorOperation* totalPmo;
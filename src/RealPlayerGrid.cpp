@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "RealPlayerGrid.h"
+
+#include <cmath>
+#include <mutex>
+
+#include "Player.h"
+
+int32 RealPlayerGrid::GetCell(float coord) { return int32(std::floor(coord / REAL_PLAYER_GRID_CELL_SIZE)); }
+
+uint64 RealPlayerGrid::GetCellKey(uint32 mapId, int32 cellX, int32 cellY)
+{
+    return (uint64(mapId) << 32) | (uint64(uint16(cellX)) << 16) | uint64(uint16(cellY));
+}
+
+void RealPlayerGrid::Add(PlayerCells& cells, uint32 mapId, float x, float y, float z, bool viewpoint)
+{
+    PlayerPosition position;
+    position.x = x;
+    position.y = y;
+    position.z = z;
+    position.viewpoint = viewpoint;
+    cells[GetCellKey(mapId, GetCell(x), GetCell(y))].push_back(position);
+}
+
+void RealPlayerGrid::Update(std::vector<Player*> const& players)
+{
+    PlayerCells newCells;
+    for (Player* player : players)
+    {
+        if (player->IsGameMaster() && !player->isGMVisible())
+            continue;
+
+        if (!player->IsInWorld())
+            continue;
+
+        uint32 mapId = player->GetMapId();
+        Add(newCells, mapId, player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), false);
+
+        WorldObject* viewObj = player->GetViewpoint();
+        if (viewObj && viewObj != player)
+            Add(newCells, mapId, viewObj->GetPositionX(), viewObj->GetPositionY(), viewObj->GetPositionZ(), true);
+    }
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+    cells.swap(newCells);
+}
+
+bool RealPlayerGrid::HasPlayerNearby(uint32 mapId, float x, float y, float z, float range)
+{
+    float sqRange = range * range;
+
+    std::shared_lock<std::shared_mutex> guard(lock);
+    if (cells.empty())
+        return false;
+
+    for (int32 cellX = GetCell(x - range); cellX <= GetCell(x + range); ++cellX)
+    {
+        for (int32 cellY = GetCell(y - range); cellY <= GetCell(y + range); ++cellY)
+        {
+            PlayerCells::const_iterator i = cells.find(GetCellKey(mapId, cellX, cellY));
+            if (i == cells.end())
+                continue;
+
+            for (PlayerPosition const& position : i->second)
+            {
+                float dx = position.x - x;
+                float dy = position.y - y;
+                float dz = position.z - z;
+                if (dx * dx + dy * dy + dz * dz < sqRange)
+                    return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool RealPlayerGrid::HasPlayersNearby(uint32 mapId, float x, float y, float range, uint32 count)
+{
+    float sqRange = range * range;
+    uint32 found = 0;
+
+    std::shared_lock<std::shared_mutex> guard(lock);
+    if (cells.empty())
+        return false;
+
+    for (int32 cellX = GetCell(x - range); cellX <= GetCell(x + range); ++cellX)
+    {
+        for (int32 cellY = GetCell(y - range); cellY <= GetCell(y + range); ++cellY)
+        {
+            PlayerCells::const_iterator i = cells.find(GetCellKey(mapId, cellX, cellY));
+            if (i == cells.end())
+                continue;
+
+            for (PlayerPosition const& position : i->second)
+            {
+                if (position.viewpoint)
+                    continue;
+
+                float dx = position.x - x;
+                float dy = position.y - y;
+                if (dx * dx + dy * dy < sqRange && ++found >= count)
+                    return true;
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_REALPLAYERGRID_H
+#define _PLAYERBOT_REALPLAYERGRID_H
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+
+class Player;
+
+#define REAL_PLAYER_GRID_CELL_SIZE 100.0f
+
+// Positions of the real players, bucketed by map and grid cell. Rebuilt once per world update,
+// so bots asking whether players are around only look at the cells within range instead of every player.
+class RealPlayerGrid
+{
+public:
+    RealPlayerGrid(){};
+    virtual ~RealPlayerGrid(){};
+    static RealPlayerGrid* instance()
+    {
+        static RealPlayerGrid instance;
+        return &instance;
+    }
+
+public:
+    void Update(std::vector<Player*> const& players);
+    // players or their far sight / cinematic camera within the 3d range
+    bool HasPlayerNearby(uint32 mapId, float x, float y, float z, float range);
+    // at least count players within the 2d range
+    bool HasPlayersNearby(uint32 mapId, float x, float y, float range, uint32 count);
+
+private:
+    struct PlayerPosition
+    {
+        float x, y, z;
+        bool viewpoint;
+    };
+
+    typedef std::unordered_map<uint64, std::vector<PlayerPosition>> PlayerCells;
+
+    static int32 GetCell(float coord);
+    static uint64 GetCellKey(uint32 mapId, int32 cellX, int32 cellY);
+    static void Add(PlayerCells& cells, uint32 mapId, float x, float y, float z, bool viewpoint);
+
+    PlayerCells cells;
+    std::shared_mutex lock;
+};
+
+#define sRealPlayerGrid RealPlayerGrid::instance()
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "SpellBook.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+
+#include "Pet.h"
+#include "Player.h"
+#include "SpellMgr.h"
+#include "SpellNameIndex.h"
+#include "Timer.h"
+
+uint32 SpellBook::GetSpellId(Player* bot, std::string const& name, std::set<uint32> const& itemIds, int32 saveMana)
+{
+    Update(bot);
+
+    std::string const key = SpellNameIndex::ToLower(name);
+    SpellBookEntries::const_iterator i = spells.find(key);
+
+    if (itemIds.empty())
+    {
+        if (i == spells.end())
+        {
+            i = petSpells.find(key);
+            if (i == petSpells.end())
+                return 0;
+        }
+
+        return Select(i->second, saveMana);
+    }
+
+    // spells creating one of the items count as well
+    std::set<uint32> spellIds;
+    if (i != spells.end())
+        spellIds.insert(i->second.spells.begin(), i->second.spells.end());
+
+    for (uint32 itemId : itemIds)
+    {
+        std::unordered_map<uint32, std::vector<uint32>>::const_iterator j = itemSpells.find(itemId);
+        if (j != itemSpells.end())
+            spellIds.insert(j->second.begin(), j->second.end());
+    }
+
+    if (spellIds.empty())
+    {
+        i = petSpells.find(key);
+        if (i == petSpells.end())
+            return 0;
+
+        return Select(i->second, saveMana);
+    }
+
+    SpellBookEntry entry;
+    entry.spells.assign(spellIds.rbegin(), spellIds.rend());
+    entry.highestRank = GetHighestRank(entry.spells);
+    return Select(entry, saveMana);
+}
+
+void SpellBook::Update(Player* bot)
+{
+    Pet* botPet = bot->GetPet();
+    ObjectGuid petGuid = botPet ? botPet->GetGUID() : ObjectGuid::Empty;
+    uint32 petSpellTotal = botPet ? botPet->m_spells.size() : 0;
+    uint32 now = getMSTime();
+
+    if (loadTime && bot->GetSpellMap().size() == spellCount && bot->GetActiveSpec() == spec &&
+        bot->GetFreeTalentPoints() == talentPoints && petGuid == pet && petSpellTotal == petSpellCount &&
+        getMSTimeDiff(loadTime, now) < SPELL_BOOK_MAX_AGE)
+        return;
+
+    spellCount = bot->GetSpellMap().size();
+    spec = bot->GetActiveSpec();
+    talentPoints = bot->GetFreeTalentPoints();
+    pet = petGuid;
+    petSpellCount = petSpellTotal;
+    loadTime = now;
+
+    spells.clear();
+    petSpells.clear();
+    itemSpells.clear();
+
+    for (PlayerSpellMap::const_iterator itr = bot->GetSpellMap().begin(); itr != bot->GetSpellMap().end(); ++itr)
+    {
+        if (itr->second->State == PLAYERSPELL_REMOVED || !itr->second->Active)
+            continue;
+
+        uint32 spellId = itr->first;
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+        if (!spellInfo || spellInfo->IsPassive())
+            continue;
+
+        if (spellInfo->Effects[0].Effect == SPELL_EFFECT_LEARN_SPELL)
+            continue;
+
+        for (uint8 effect = 0; effect < 3; ++effect)
+        {
+            if (spellInfo->Effects[effect].Effect == SPELL_EFFECT_CREATE_ITEM)
+                itemSpells[spellInfo->Effects[effect].ItemType].push_back(spellId);
+        }
+
+        AddSpell(spells, spellInfo->SpellName[LOCALE_enUS], spellId);
+    }
+
+    if (botPet)
+    {
+        for (PetSpellMap::const_iterator itr = botPet->m_spells.begin(); itr != botPet->m_spells.end(); ++itr)
+        {
+            if (itr->second.state == PETSPELL_REMOVED)
+                continue;
+
+            uint32 spellId = itr->first;
+            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+            if (!spellInfo)
+                continue;
+
+            if (spellInfo->Effects[0].Effect == SPELL_EFFECT_LEARN_SPELL)
+                continue;
+
+            AddSpell(petSpells, spellInfo->SpellName[LOCALE_enUS], spellId);
+        }
+    }
+
+    Sort(spells);
+    Sort(petSpells);
+    for (std::unordered_map<uint32, std::vector<uint32>>::iterator i = itemSpells.begin(); i != itemSpells.end(); ++i)
+        std::sort(i->second.begin(), i->second.end(), std::greater<uint32>());
+}
+
+void SpellBook::AddSpell(SpellBookEntries& entries, std::string const& name, uint32 spellId)
+{
+    if (name.empty())
+        return;
+
+    entries[SpellNameIndex::ToLower(name)].spells.push_back(spellId);
+}
+
+void SpellBook::Sort(SpellBookEntries& entries)
+{
+    for (SpellBookEntries::iterator i = entries.begin(); i != entries.end(); ++i)
+    {
+        std::vector<uint32>& spells = i->second.spells;
+        std::sort(spells.begin(), spells.end(), std::greater<uint32>());
+        spells.erase(std::unique(spells.begin(), spells.end()), spells.end());
+        i->second.highestRank = GetHighestRank(spells);
+    }
+}
+
+uint32 SpellBook::GetHighestRank(std::vector<uint32> const& spells)
+{
+    uint32 highestRank = 0;
+    uint32 highestSpellId = 0;
+    for (uint32 spellId : spells)
+    {
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+        if (!spellInfo)
+            continue;
+
+        // the rank text is "Rank N", spells without a number there are taken as they come
+        char const* rankText = spellInfo->Rank[0];
+        while (*rankText && !isdigit(*rankText))
+            ++rankText;
+
+        uint32 rank = atoi(rankText);
+        if (!rank)
+        {
+            highestSpellId = spellId;
+            continue;
+        }
+
+        if (!highestRank || rank > highestRank)
+        {
+            highestRank = rank;
+            highestSpellId = spellId;
+        }
+    }
+
+    return highestSpellId;
+}
+
+uint32 SpellBook::Select(SpellBookEntry const& entry, int32 saveMana)
+{
+    if (saveMana <= 1)
+        return entry.highestRank;
+
+    // the n-th highest rank for mana save level n, the lowest rank if there are fewer
+    if (uint32(saveMana) <= entry.spells.size())
+        return entry.spells[saveMana - 1];
+
+    return entry.spells.back();
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_SPELLBOOK_H
+#define _PLAYERBOT_SPELLBOOK_H
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+class Player;
+
+#define SPELL_BOOK_MAX_AGE 60000  // ms before the index is rebuilt even if the bot's spells look unchanged
+
+// Castable spells of a bot and its pet by lowercase name, highest id first, with the spell the
+// "spell id" value picks when no mana is saved. Rebuilt when the bot's spell book, spec, talent
+// points or pet change.
+class SpellBook
+{
+public:
+    SpellBook() : spellCount(0), spec(0), talentPoints(0), petSpellCount(0), loadTime(0) {}
+
+    uint32 GetSpellId(Player* bot, std::string const& name, std::set<uint32> const& itemIds, int32 saveMana);
+
+private:
+    struct SpellBookEntry
+    {
+        std::vector<uint32> spells;
+        uint32 highestRank = 0;
+    };
+
+    typedef std::unordered_map<std::string, SpellBookEntry> SpellBookEntries;
+
+    void Update(Player* bot);
+    static void AddSpell(SpellBookEntries& entries, std::string const& name, uint32 spellId);
+    static void Sort(SpellBookEntries& entries);
+    static uint32 GetHighestRank(std::vector<uint32> const& spells);
+    static uint32 Select(SpellBookEntry const& entry, int32 saveMana);
+
+    SpellBookEntries spells;
+    SpellBookEntries petSpells;
+    std::unordered_map<uint32, std::vector<uint32>> itemSpells;  // created item -> spells
+
+    uint32 spellCount;
+    uint8 spec;
+    uint32 talentPoints;
+    ObjectGuid pet;
+    uint32 petSpellCount;
+    uint32 loadTime;
+};
+
+#endif
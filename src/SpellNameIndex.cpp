@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "SpellNameIndex.h"
+
+#include "Log.h"
+#include "SpellMgr.h"
+#include "Timer.h"
+
+void SpellNameIndex::Load()
+{
+    // spells never change at runtime, a config reload keeps the index bots are reading
+    if (!spells.empty())
+        return;
+
+    LOG_INFO("server.loading", "Loading spell name index...");
+
+    uint32 oldMSTime = getMSTime();
+
+    for (uint32 spellId = 1; spellId < sSpellMgr->GetSpellInfoStoreSize(); ++spellId)
+    {
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+        if (!spellInfo || !spellInfo->SpellName[0] || !*spellInfo->SpellName[0])
+            continue;
+
+        spells[ToLower(spellInfo->SpellName[0])].push_back(spellId);
+    }
+
+    LOG_INFO("server.loading", ">> Loaded {} spell names in {} ms", spells.size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
+std::vector<uint32> const& SpellNameIndex::Find(std::string const& name) const
+{
+    static std::vector<uint32> const empty;
+
+    std::unordered_map<std::string, std::vector<uint32>>::const_iterator i = spells.find(ToLower(name));
+    return i == spells.end() ? empty : i->second;
+}
+
+std::string SpellNameIndex::ToLower(std::string const& name)
+{
+    // spell names are compared case insensitively by their ascii letters, like Utf8FitTo does for english names
+    std::string lower = name;
+    for (char& c : lower)
+    {
+        if (c >= 'A' && c <= 'Z')
+            c = c - 'A' + 'a';
+    }
+
+    return lower;
+}
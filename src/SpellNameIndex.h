@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_SPELLNAMEINDEX_H
+#define _PLAYERBOT_SPELLNAMEINDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+
+// Ids of all spells by lowercase name, so spells and auras can be looked up by name
+// without comparing the name of every aura or spell a unit has.
+class SpellNameIndex
+{
+public:
+    SpellNameIndex(){};
+    virtual ~SpellNameIndex(){};
+    static SpellNameIndex* instance()
+    {
+        static SpellNameIndex instance;
+        return &instance;
+    }
+
+public:
+    void Load();
+    std::vector<uint32> const& Find(std::string const& name) const;
+
+    static std::string ToLower(std::string const& name);
+
+private:
+    std::unordered_map<std::string, std::vector<uint32>> spells;
+};
+
+#define sSpellNameIndex SpellNameIndex::instance()
+
+#endif
@@ -1729,9 +1729,9 @@ void TravelMgr::LoadQuestTravelTable()
     Clear();
 
     /* remove this
-    questGuidMap cQuestMap = GAI_VALUE(questGuidMap,"quest objects");
+    std::shared_ptr<questGuidMap const> cQuestMap = GAI_SNAPSHOT(questGuidMap, "quest objects");
 
-    for (auto cQuest : cQuestMap)
+    for (auto const& cQuest : *cQuestMap)
     {
         LOG_INFO("playerbots", "[Quest id: {}]", cQuest.first);
 
@@ -1915,9 +1915,9 @@ void TravelMgr::LoadQuestTravelTable()
     bool loadQuestData = true;
     if (loadQuestData)
     {
-        questGuidpMap questMap = GAI_VALUE(questGuidpMap, "quest guidp map");
+        std::shared_ptr<questGuidpMap const> questMap = GAI_SNAPSHOT(questGuidpMap, "quest guidp map");
 
-        for (auto& q : questMap)
+        for (auto& q : *questMap)
         {
             uint32 questId = q.first;
 
@@ -1975,10 +1975,10 @@ void TravelMgr::LoadQuestTravelTable()
 
                     for (auto& guidP : e.second)
                     {
-                        WorldPosition point = guidP;
+                        WorldPosition* point = storePoint(guidP);
                         for (auto tLoc : locs)
                         {
-                            tLoc->addPoint(&point);
+                            tLoc->addPoint(point);
                         }
                     }
                 }
@@ -2189,6 +2189,7 @@ void TravelMgr::LoadQuestTravelTable()
         allowedNpcFlags.push_back(UNIT_NPC_FLAG_REPAIR);
 
         point = WorldPosition(u.map, u.x, u.y, u.z, u.o);
+        WorldPosition* unitPoint = storePoint(point);
 
         for (std::vector<uint32>::iterator i = allowedNpcFlags.begin(); i != allowedNpcFlags.end(); ++i)
         {
@@ -2199,7 +2200,7 @@ void TravelMgr::LoadQuestTravelTable()
                 rLoc->setExpireDelay(5 * 60 * 1000);
                 rLoc->setMaxVisitors(15, 0);
 
-                rLoc->addPoint(&point);
+                rLoc->addPoint(unitPoint);
                 rpgNpcs.push_back(rLoc);
                 break;
             }
@@ -2212,8 +2213,7 @@ void TravelMgr::LoadQuestTravelTable()
             gLoc->setExpireDelay(5 * 60 * 1000);
             gLoc->setMaxVisitors(100, 0);
 
-            point = WorldPosition(u.map, u.x, u.y, u.z, u.o);
-            gLoc->addPoint(&point);
+            gLoc->addPoint(unitPoint);
             grindMobs.push_back(gLoc);
         }
 
@@ -2226,7 +2226,7 @@ void TravelMgr::LoadQuestTravelTable()
             bLoc->setExpireDelay(5 * 60 * 1000);
             bLoc->setMaxVisitors(0, 0);
 
-            bLoc->addPoint(&point);
+            bLoc->addPoint(unitPoint);
             bossMobs.push_back(bLoc);
         }
     }
@@ -2267,9 +2267,11 @@ void TravelMgr::LoadQuestTravelTable()
             loc = iloc->second;
         }
 
-        loc->addPoint(&point);
+        loc->addPoint(storePoint(point));
     }
 
+    indexDestinations();
+
     // Clear these logs files
     sPlayerbotAIConfig->openLog("zones.csv", "w");
     sPlayerbotAIConfig->openLog("creatures.csv", "w");
@@ -3872,6 +3874,154 @@ bool TravelMgr::getObjectiveStatus(Player* bot, Quest const* pQuest, uint32 obje
     return false;
 }
 
+void TravelDestinationIndex::clear()
+{
+    entries.clear();
+    maps.clear();
+    destinations = 0;
+}
+
+void TravelDestinationIndex::add(TravelDestination* destination, int32 level)
+{
+    uint32 order = destinations++;
+
+    for (auto& point : destination->getPoints(true))
+    {
+        Entry entry{destination, order, level, point->getX(), point->getY()};
+        entries.push_back(entry);
+
+        int32 x = getGridCoord(entry.x);
+        int32 y = getGridCoord(entry.y);
+
+        std::pair<std::unordered_map<uint32, MapGrid>::iterator, bool> inserted =
+            maps.insert(std::make_pair(point->getMapId(), MapGrid()));
+        MapGrid& grid = inserted.first->second;
+
+        if (inserted.second)
+        {
+            grid.minX = grid.maxX = x;
+            grid.minY = grid.maxY = y;
+        }
+        else
+        {
+            grid.minX = std::min(grid.minX, x);
+            grid.maxX = std::max(grid.maxX, x);
+            grid.minY = std::min(grid.minY, y);
+            grid.maxY = std::max(grid.maxY, y);
+        }
+
+        grid.cells[getGridKey(x, y)].push_back(entry);
+    }
+}
+
+void TravelDestinationIndex::addCandidates(std::vector<Entry const*>& candidates, uint32 mapId, float x, float y,
+                                           float range, int32 minLevel, int32 maxLevel)
+{
+    std::unordered_map<uint32, MapGrid>::iterator gridItr = maps.find(mapId);
+    if (gridItr == maps.end())
+        return;
+
+    MapGrid& grid = gridItr->second;
+
+    // Clamp in float first, the range can reach past any cell coordinate.
+    int32 startX = std::max<float>(std::floor((x - range) / TRAVEL_DESTINATION_GRID_SIZE), grid.minX);
+    int32 endX = std::min<float>(std::floor((x + range) / TRAVEL_DESTINATION_GRID_SIZE), grid.maxX);
+    int32 startY = std::max<float>(std::floor((y - range) / TRAVEL_DESTINATION_GRID_SIZE), grid.minY);
+    int32 endY = std::min<float>(std::floor((y + range) / TRAVEL_DESTINATION_GRID_SIZE), grid.maxY);
+
+    // Points are compared in 2d, which never rejects a point the 3d distance would accept.
+    float sqRange = range * range;
+
+    for (int32 cellX = startX; cellX <= endX; ++cellX)
+    {
+        for (int32 cellY = startY; cellY <= endY; ++cellY)
+        {
+            std::unordered_map<uint64, std::vector<Entry>>::iterator cell = grid.cells.find(getGridKey(cellX, cellY));
+            if (cell == grid.cells.end())
+                continue;
+
+            for (auto& entry : cell->second)
+            {
+                if (entry.level < minLevel || entry.level > maxLevel)
+                    continue;
+
+                if ((entry.x - x) * (entry.x - x) + (entry.y - y) * (entry.y - y) > sqRange)
+                    continue;
+
+                candidates.push_back(&entry);
+            }
+        }
+    }
+}
+
+std::vector<TravelDestination*> TravelDestinationIndex::getCandidates(WorldPosition pos, float maxDistance,
+                                                                      int32 minLevel, int32 maxLevel)
+{
+    std::vector<Entry const*> candidates;
+
+    if (maxDistance > 0)
+    {
+        addCandidates(candidates, pos.getMapId(), pos.getX(), pos.getY(), maxDistance, minLevel, maxLevel);
+
+        // Destinations on other maps are measured like TravelDestination::distanceTo does: point.distance(pos)
+        // takes the transfers from the destination map to pos' map, entering at pointFrom and leaving at pointTo.
+        for (auto& mapTransfers : sTravelMgr->mapTransfersMap)
+        {
+            if (mapTransfers.first.second != pos.getMapId() || mapTransfers.first.first == pos.getMapId())
+                continue;
+
+            for (auto& mapTrans : mapTransfers.second)
+            {
+                float range = maxDistance - mapTrans.getPointTo()->distance(pos) - mapTrans.getPortalLength();
+                if (range < 0)
+                    continue;
+
+                WorldPosition* pointFrom = mapTrans.getPointFrom();
+                addCandidates(candidates, pointFrom->getMapId(), pointFrom->getX(), pointFrom->getY(), range,
+                              minLevel, maxLevel);
+            }
+        }
+    }
+    else
+    {
+        for (auto& entry : entries)
+            if (entry.level >= minLevel && entry.level <= maxLevel)
+                candidates.push_back(&entry);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](Entry const* i, Entry const* j) { return i->order < j->order; });
+
+    std::vector<TravelDestination*> retVec;
+    retVec.reserve(candidates.size());
+    for (auto& entry : candidates)
+        if (retVec.empty() || retVec.back() != entry->destination)
+            retVec.push_back(entry->destination);
+
+    return retVec;
+}
+
+void TravelMgr::indexDestinations()
+{
+    questGiverIndex.clear();
+    for (auto& dest : questGivers)
+        questGiverIndex.add(dest, dest->GetQuestTemplate() ? dest->GetQuestTemplate()->GetQuestLevel() : 0);
+
+    rpgNpcIndex.clear();
+    for (auto& dest : rpgNpcs)
+        rpgNpcIndex.add(dest);
+
+    grindMobIndex.clear();
+    for (auto& dest : grindMobs)
+    {
+        CreatureTemplate const* cInfo = dest->GetCreatureTemplate();
+        grindMobIndex.add(dest, cInfo ? cInfo->maxlevel : 0);
+    }
+
+    bossMobIndex.clear();
+    for (auto& dest : bossMobs)
+        bossMobIndex.add(dest);
+}
+
 std::vector<TravelDestination*> TravelMgr::getQuestTravelDestinations(Player* bot, int32 questId, bool ignoreFull,
                                                                       bool ignoreInactive, float maxDistance,
                                                                       bool ignoreObjectives)
@@ -3882,15 +4032,19 @@ std::vector<TravelDestination*> TravelMgr::getQuestTravelDestinations(Player* bo
 
     if (questId == -1)
     {
-        for (auto& dest : questGivers)
+        // Quest givers of quests 5 or more levels above the bot are never active.
+        int32 maxLevel = ignoreInactive ? std::numeric_limits<int32>::max() : int32(bot->GetLevel()) + 4;
+
+        for (auto& dest : questGiverIndex.getCandidates(botLocation, maxDistance,
+                                                        std::numeric_limits<int32>::min(), maxLevel))
         {
-            if (!ignoreInactive && !dest->isActive(bot))
+            if (maxDistance > 0 && dest->distanceTo(&botLocation) > maxDistance)
                 continue;
 
             if (dest->isFull(ignoreFull))
                 continue;
 
-            if (maxDistance > 0 && dest->distanceTo(&botLocation) > maxDistance)
+            if (!ignoreInactive && !dest->isActive(bot))
                 continue;
 
             retTravelLocations.push_back(dest);
@@ -3943,15 +4097,15 @@ std::vector<TravelDestination*> TravelMgr::getRpgTravelDestinations(Player* bot,
 
     std::vector<TravelDestination*> retTravelLocations;
 
-    for (auto& dest : rpgNpcs)
+    for (auto& dest : rpgNpcIndex.getCandidates(botLocation, maxDistance))
     {
-        if (!ignoreInactive && !dest->isActive(bot))
+        if (maxDistance > 0 && dest->distanceTo(&botLocation) > maxDistance)
             continue;
 
         if (dest->isFull(ignoreFull))
             continue;
 
-        if (maxDistance > 0 && dest->distanceTo(&botLocation) > maxDistance)
+        if (!ignoreInactive && !dest->isActive(bot))
             continue;
 
         retTravelLocations.push_back(dest);
@@ -3988,15 +4142,26 @@ std::vector<TravelDestination*> TravelMgr::getGrindTravelDestinations(Player* bo
 
     std::vector<TravelDestination*> retTravelLocations;
 
-    for (auto& dest : grindMobs)
+    // Widest level band GrindTravelDestination::isActive can accept for this bot at any durability,
+    // with a level of slack for rounding.
+    int32 minLevel = std::numeric_limits<int32>::min();
+    int32 maxLevel = std::numeric_limits<int32>::max();
+    if (!ignoreInactive)
     {
-        if (!ignoreInactive && !dest->isActive(bot))
+        float botLevel = bot->GetLevel();
+        minLevel = int32(std::max(botLevel * 0.4f, botLevel - 12.0f)) - 1;
+        maxLevel = int32(std::max(botLevel * 0.7f, botLevel - 3.0f)) + 1;
+    }
+
+    for (auto& dest : grindMobIndex.getCandidates(botLocation, maxDistance, minLevel, maxLevel))
+    {
+        if (maxDistance > 0 && dest->distanceTo(&botLocation) > maxDistance)
             continue;
 
         if (dest->isFull(ignoreFull))
             continue;
 
-        if (maxDistance > 0 && dest->distanceTo(&botLocation) > maxDistance)
+        if (!ignoreInactive && !dest->isActive(bot))
             continue;
 
         retTravelLocations.push_back(dest);
@@ -7,6 +7,9 @@
 #define _PLAYERBOT_TRAVELMGR_H
 
 #include <boost/functional/hash.hpp>
+#include <cmath>
+#include <deque>
+#include <limits>
 #include <random>
 
 #include "AiObject.h"
@@ -467,6 +470,8 @@ public:
 
     WorldPosition* getPointTo() { return &pointTo; }
 
+    float getPortalLength() { return portalLength; }
+
     bool isUseful(WorldPosition point) { return isFrom(point) || isTo(point); }
 
     float distance(WorldPosition point)
@@ -840,6 +845,49 @@ protected:
     WorldPosition* wPosition = nullptr;
 };
 
+// Edge length in yards of the grid cells destinations are bucketed in.
+#define TRAVEL_DESTINATION_GRID_SIZE 533.3333f
+
+// Destinations of one kind bucketed by map and grid cell of their points.
+// Lets destination queries reject far away or out of level destinations before the expensive isActive check.
+class TravelDestinationIndex
+{
+public:
+    void clear();
+    void add(TravelDestination* destination, int32 level = 0);
+
+    // Destinations with a point that may be within maxDistance of pos (directly or through a map transfer)
+    // and a level in [minLevel, maxLevel], in the order they were added. The exact distance is left to the caller.
+    std::vector<TravelDestination*> getCandidates(WorldPosition pos, float maxDistance,
+                                                  int32 minLevel = std::numeric_limits<int32>::min(),
+                                                  int32 maxLevel = std::numeric_limits<int32>::max());
+
+private:
+    struct Entry
+    {
+        TravelDestination* destination;
+        uint32 order;
+        int32 level;
+        float x, y;
+    };
+
+    struct MapGrid
+    {
+        std::unordered_map<uint64, std::vector<Entry>> cells;
+        int32 minX = 0, maxX = 0, minY = 0, maxY = 0;
+    };
+
+    static int32 getGridCoord(float coord) { return int32(std::floor(coord / TRAVEL_DESTINATION_GRID_SIZE)); }
+    static uint64 getGridKey(int32 x, int32 y) { return (uint64(uint32(x)) << 32) | uint32(y); }
+
+    void addCandidates(std::vector<Entry const*>& candidates, uint32 mapId, float x, float y, float range,
+                       int32 minLevel, int32 maxLevel);
+
+    std::vector<Entry> entries;
+    std::unordered_map<uint32, MapGrid> maps;
+    uint32 destinations = 0;
+};
+
 // General container for all travel destinations.
 class TravelMgr
 {
@@ -893,6 +941,15 @@ public:
 
     void setNullTravelTarget(Player* player);
 
+    // Keeps a point alive for the lifetime of the destinations using it.
+    WorldPosition* storePoint(WorldPosition const& point)
+    {
+        destinationPoints.push_back(point);
+        return &destinationPoints.back();
+    }
+
+    void indexDestinations();
+
     void addMapTransfer(WorldPosition start, WorldPosition end, float portalDistance = 0.1f, bool makeShortcuts = true);
     void loadMapTransfers();
     float mapTransDistance(WorldPosition start, WorldPosition end);
@@ -928,6 +985,13 @@ public:
     std::vector<GrindTravelDestination*> grindMobs;
     std::vector<BossTravelDestination*> bossMobs;
 
+    TravelDestinationIndex questGiverIndex;
+    TravelDestinationIndex rpgNpcIndex;
+    TravelDestinationIndex grindMobIndex;
+    TravelDestinationIndex bossMobIndex;
+
+    std::deque<WorldPosition> destinationPoints;
+
     std::unordered_map<uint32, ExploreTravelDestination*> exploreLocs;
     std::unordered_map<uint32, QuestContainer*> quests;
 
@@ -6,6 +6,7 @@
 #include "TravelNode.h"
 
 #include <iomanip>
+#include <mutex>
 #include <regex>
 
 #include "BudgetValues.h"
@@ -306,6 +307,30 @@ TravelNodePath* TravelNode::buildPath(TravelNode* endNode, Unit* bot, bool postP
     return returnNodePath;
 }
 
+namespace
+{
+std::mutex nodeIdLock;
+uint32 nodeIdCount = 0;
+std::vector<uint32> freeNodeIds;
+}  // namespace
+
+uint32 TravelNode::allocateId()
+{
+    std::lock_guard<std::mutex> guard(nodeIdLock);
+    if (freeNodeIds.empty())
+        return nodeIdCount++;
+
+    uint32 id = freeNodeIds.back();
+    freeNodeIds.pop_back();
+    return id;
+}
+
+void TravelNode::releaseId(uint32 id)
+{
+    std::lock_guard<std::mutex> guard(nodeIdLock);
+    freeNodeIds.push_back(id);
+}
+
 // Generic routine to remove references to nodes.
 void TravelNode::removeLinkTo(TravelNode* node, bool removePaths)
 {
@@ -1055,6 +1080,7 @@ TravelNodeMap::TravelNodeMap(TravelNodeMap* baseMap)
         newNode = new TravelNode(node);
 
         m_nodes.push_back(newNode);
+        indexNode(newNode);
     }
 
     for (auto& node : baseMap->getNodes())
@@ -1106,6 +1132,7 @@ TravelNode* TravelNodeMap::addNode(WorldPosition pos, std::string const prefered
     newNode = new TravelNode(pos, finalName, isImportant);
 
     m_nodes.push_back(newNode);
+    indexNode(newNode);
 
     return newNode;
 }
@@ -1118,6 +1145,7 @@ void TravelNodeMap::removeNode(TravelNode* node)
     {
         if (tnode == node)
         {
+            unindexNode(tnode);
             delete tnode;
             tnode = nullptr;
         }
@@ -1146,22 +1174,136 @@ void TravelNodeMap::fullLinkNode(TravelNode* startNode, Unit* bot)
     startNode->setLinked(true);
 }
 
-std::vector<TravelNode*> TravelNodeMap::getNodes(WorldPosition pos, float range)
+void TravelNodeMap::indexNode(TravelNode* node)
+{
+    int32 x = getGridCoord(node->getX());
+    int32 y = getGridCoord(node->getY());
+
+    std::pair<std::unordered_map<uint32, NodeGrid>::iterator, bool> inserted =
+        m_grids.insert(std::make_pair(node->getMapId(), NodeGrid()));
+    NodeGrid& grid = inserted.first->second;
+
+    if (inserted.second)
+    {
+        grid.minX = grid.maxX = x;
+        grid.minY = grid.maxY = y;
+    }
+    else
+    {
+        grid.minX = std::min(grid.minX, x);
+        grid.maxX = std::max(grid.maxX, x);
+        grid.minY = std::min(grid.minY, y);
+        grid.maxY = std::max(grid.maxY, y);
+    }
+
+    grid.cells[getGridKey(x, y)].push_back(node);
+    grid.nodes.push_back(node);
+}
+
+void TravelNodeMap::unindexNode(TravelNode* node)
+{
+    std::unordered_map<uint32, NodeGrid>::iterator grid = m_grids.find(node->getMapId());
+    if (grid == m_grids.end())
+        return;
+
+    std::unordered_map<uint64, std::vector<TravelNode*>>::iterator cell =
+        grid->second.cells.find(getGridKey(getGridCoord(node->getX()), getGridCoord(node->getY())));
+    if (cell != grid->second.cells.end())
+    {
+        cell->second.erase(std::remove(cell->second.begin(), cell->second.end(), node), cell->second.end());
+        if (cell->second.empty())
+            grid->second.cells.erase(cell);
+    }
+
+    std::vector<TravelNode*>& nodes = grid->second.nodes;
+    nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+}
+
+std::vector<TravelNode*> TravelNodeMap::getNodes(WorldPosition pos, float range, uint32 limit)
 {
     std::vector<TravelNode*> retVec;
 
-    for (auto& node : m_nodes)
+    std::unordered_map<uint32, NodeGrid>::iterator gridItr = m_grids.find(pos.getMapId());
+    if (gridItr == m_grids.end())
+        return retVec;
+
+    NodeGrid& grid = gridItr->second;
+    std::vector<std::pair<float, TravelNode*>> found;
+
+    if (range == -1 && !limit)
+    {
+        found.reserve(grid.nodes.size());
+        for (auto& node : grid.nodes)
+            found.push_back(std::make_pair(node->getDistance(pos), node));
+    }
+    else
+    {
+        // Scan rings of cells around pos. Once ring r is done every node closer than r cells has been seen.
+        int32 x = getGridCoord(pos.getX());
+        int32 y = getGridCoord(pos.getY());
+        int32 maxRing = std::max(std::max(x - grid.minX, grid.maxX - x), std::max(y - grid.minY, grid.maxY - y));
+
+        auto scanCell = [&](int32 cellX, int32 cellY)
+        {
+            if (cellX < grid.minX || cellX > grid.maxX || cellY < grid.minY || cellY > grid.maxY)
+                return;
+
+            std::unordered_map<uint64, std::vector<TravelNode*>>::iterator cell =
+                grid.cells.find(getGridKey(cellX, cellY));
+            if (cell == grid.cells.end())
+                return;
+
+            for (auto& node : cell->second)
+            {
+                float distance = node->getDistance(pos);
+                if (range == -1 || distance <= range)
+                    found.push_back(std::make_pair(distance, node));
+            }
+        };
+
+        for (int32 ring = 0; ring <= maxRing; ++ring)
+        {
+            if (!ring)
+                scanCell(x, y);
+            else
+            {
+                for (int32 i = -ring; i <= ring; ++i)
+                {
+                    scanCell(x + i, y - ring);
+                    scanCell(x + i, y + ring);
+                }
+
+                for (int32 i = -ring + 1; i < ring; ++i)
+                {
+                    scanCell(x - ring, y + i);
+                    scanCell(x + ring, y + i);
+                }
+            }
+
+            float reach = ring * TRAVEL_NODE_GRID_SIZE;
+            if (range != -1 && reach >= range)
+                break;
+
+            if (limit && found.size() >= limit &&
+                uint32(std::count_if(found.begin(), found.end(), [reach](std::pair<float, TravelNode*> const& i)
+                                     { return i.first <= reach; })) >= limit)
+                break;
+        }
+    }
+
+    if (limit && found.size() > limit)
     {
-        if (node->getMapId() == pos.getMapId())
-            if (range == -1 || node->getDistance(pos) <= range)
-                retVec.push_back(node);
+        std::partial_sort(found.begin(), found.begin() + limit, found.end());
+        found.resize(limit);
     }
+    else
+        std::sort(found.begin(), found.end());
 
-    std::sort(retVec.begin(), retVec.end(),
-              [pos](TravelNode* i, TravelNode* j)
-              { return i->getPosition()->distance(pos) < j->getPosition()->distance(pos); });
+    retVec.reserve(found.size());
+    for (auto& node : found)
+        retVec.push_back(node.second);
 
-    return std::move(retVec);
+    return retVec;
 }
 
 TravelNode* TravelNodeMap::getNode(WorldPosition pos, [[maybe_unused]] std::vector<WorldPosition>& ppath, Unit* bot,
@@ -1176,7 +1318,7 @@ TravelNode* TravelNodeMap::getNode(WorldPosition pos, [[maybe_unused]] std::vect
 
     uint32 c = 0;
 
-    std::vector<TravelNode*> nodes = sTravelNodeMap->getNodes(pos, range);
+    std::vector<TravelNode*> nodes = sTravelNodeMap->getNodes(pos, range, bot ? 6 : 1);
     for (auto& node : nodes)
     {
         if (!bot || pos.canPathTo(*node->getPosition(), bot))
@@ -1191,6 +1333,103 @@ TravelNode* TravelNodeMap::getNode(WorldPosition pos, [[maybe_unused]] std::vect
     return nullptr;
 }
 
+void TravelNodeSearch::begin()
+{
+    open.clear();
+
+    if (++generation == 0)
+    {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        generation = 1;
+    }
+}
+
+TravelNodeStub* TravelNodeSearch::getStub(TravelNode* node)
+{
+    uint32 id = node->getNodeId();
+    if (id >= stamps.size())
+    {
+        stamps.resize(std::max<size_t>(id + 1, stamps.size() * 2), 0);
+        stubs.resize(stamps.size());
+    }
+
+    TravelNodeStub* stub = &stubs[id];
+    if (stamps[id] != generation)
+    {
+        *stub = TravelNodeStub(node);
+        stamps[id] = generation;
+    }
+
+    return stub;
+}
+
+void TravelNodeSearch::push(TravelNodeStub* stub)
+{
+    open.push_back(stub);
+    siftUp(open.size() - 1);
+    stub->open = true;
+}
+
+TravelNodeStub* TravelNodeSearch::pop()
+{
+    TravelNodeStub* top = open.front();
+    TravelNodeStub* last = open.back();
+    open.pop_back();
+    if (!open.empty())
+    {
+        place(0, last);
+        siftDown(0);
+    }
+
+    top->open = false;
+    return top;
+}
+
+void TravelNodeSearch::place(uint32 pos, TravelNodeStub* stub)
+{
+    open[pos] = stub;
+    stub->heapIndex = pos;
+}
+
+void TravelNodeSearch::siftUp(uint32 pos)
+{
+    TravelNodeStub* stub = open[pos];
+    while (pos > 0)
+    {
+        uint32 parent = (pos - 1) / 2;
+        if (open[parent]->m_f <= stub->m_f)
+            break;
+
+        place(pos, open[parent]);
+        pos = parent;
+    }
+
+    place(pos, stub);
+}
+
+void TravelNodeSearch::siftDown(uint32 pos)
+{
+    uint32 size = open.size();
+    TravelNodeStub* stub = open[pos];
+    while (true)
+    {
+        uint32 child = pos * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && open[child + 1]->m_f < open[child]->m_f)
+            ++child;
+
+        if (stub->m_f <= open[child]->m_f)
+            break;
+
+        place(pos, open[child]);
+        pos = child;
+    }
+
+    place(pos, stub);
+}
+
 TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Player* bot)
 {
     float botSpeed = bot ? bot->GetSpeed(MOVE_RUN) : 7.0f;
@@ -1199,9 +1438,10 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
         return TravelNodeRoute();
 
     // Basic A* algoritm
-    std::unordered_map<TravelNode*, TravelNodeStub> m_stubs;
+    TravelNodeSearch* search = TravelNodeSearch::instance();
+    search->begin();
 
-    TravelNodeStub* startStub = &m_stubs.insert(std::make_pair(start, TravelNodeStub(start))).first->second;
+    TravelNodeStub* startStub = search->getStub(start);
 
     TravelNodeStub* currentNode = nullptr;
     TravelNodeStub* childNode = nullptr;
@@ -1209,8 +1449,6 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
     float g = 0.f;
     float h = 0.f;
 
-    std::vector<TravelNodeStub*> open, closed;
-
     if (bot)
     {
         PlayerbotAI* botAI = GET_PLAYERBOT_AI(bot);
@@ -1235,6 +1473,7 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
             if (homeNode)
             {
                 PortalNode* portNode = (PortalNode*)sTravelNodeMap->teleportNodes[bot->GetGUID()][8690];
+                if (!portNode)
                 {
                     portNode = new PortalNode(start);
 
@@ -1243,42 +1482,27 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
 
                 portNode->SetPortal(start, homeNode, 8690);
 
-                childNode = &m_stubs.insert(std::make_pair(portNode, TravelNodeStub(portNode))).first->second;
+                childNode = search->getStub(portNode);
 
                 childNode->m_g = 10 * MINUTE;
                 childNode->m_h = childNode->dataNode->fDist(goal) / botSpeed;
                 childNode->m_f = childNode->m_g + childNode->m_h;
                 // childNode->parent = startStub;
 
-                open.push_back(childNode);
-                std::push_heap(open.begin(), open.end(),
-                               [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-                childNode->open = true;
+                search->push(childNode);
             }
         }
     }
 
-    if (open.size() == 0 && !start->hasRouteTo(goal))
+    if (search->empty() && !start->hasRouteTo(goal))
         return TravelNodeRoute();
 
-    std::make_heap(open.begin(), open.end(), [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
+    search->push(startStub);
 
-    open.push_back(startStub);
-    std::push_heap(open.begin(), open.end(), [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-    startStub->open = true;
-
-    while (!open.empty())
+    while (!search->empty())
     {
-        std::sort(open.begin(), open.end(), [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-
-        currentNode = open.front();  // pop n node from open for which f is minimal
-
-        std::pop_heap(open.begin(), open.end(), [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-        open.pop_back();
-        currentNode->open = false;
-
+        currentNode = search->pop();  // pop n node from open for which f is minimal
         currentNode->close = true;
-        closed.push_back(currentNode);
 
         if (currentNode->dataNode == goal ||
             (currentNode->dataNode->getMapId() != start->getMapId() && currentNode->dataNode->isWalking()))
@@ -1307,7 +1531,7 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
             if (linkCost <= 0)
                 continue;
 
-            childNode = &m_stubs.insert(std::make_pair(linkNode, TravelNodeStub(linkNode))).first->second;
+            childNode = search->getStub(linkNode);
             g = currentNode->m_g + linkCost;  // stance from start + distance between the two nodes
             if ((childNode->open || childNode->close) &&
                 childNode->m_g <= g)  // n' is already in opend or closed with a lower cost g(n')
@@ -1326,13 +1550,10 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
             if (childNode->close)
                 childNode->close = false;
 
-            if (!childNode->open)
-            {
-                open.push_back(childNode);
-                std::push_heap(open.begin(), open.end(),
-                               [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-                childNode->open = true;
-            }
+            if (childNode->open)
+                search->decreased(childNode);
+            else
+                search->push(childNode);
         }
     }
 
@@ -1399,6 +1620,7 @@ TravelNodeRoute TravelNodeMap::getRoute(WorldPosition startPos, WorldPosition en
     {
         startPath.clear();
         TravelNode* botNode = sTravelNodeMap->teleportNodes[bot->GetGUID()][0];
+        if (!botNode)
         {
             botNode = new TravelNode(startPos, "Bot Pos", false);
             sTravelNodeMap->teleportNodes[bot->GetGUID()][0] = botNode;
@@ -6,10 +6,15 @@
 #ifndef _PLAYERBOT_TRAVELNODE_H
 #define _PLAYERBOT_TRAVELNODE_H
 
+#include <cmath>
+#include <deque>
 #include <shared_mutex>
 
 #include "TravelMgr.h"
 
+// Edge length in yards of the grid cells used to find nodes near a position.
+#define TRAVEL_NODE_GRID_SIZE 256.0f
+
 // THEORY
 //
 //  Pathfinding in (c)mangos is based on detour recast an opensource nashmesh creation and pathfinding codebase.
@@ -186,10 +191,11 @@ class TravelNode
 {
 public:
     // Constructors
-    TravelNode(){};
+    TravelNode() { nodeId = allocateId(); };
 
     TravelNode(WorldPosition point1, std::string const nodeName1 = "Travel Node", bool important1 = false)
     {
+        nodeId = allocateId();
         nodeName = nodeName1;
         point = point1;
         important = important1;
@@ -197,16 +203,24 @@ public:
 
     TravelNode(TravelNode* baseNode)
     {
+        nodeId = allocateId();
         nodeName = baseNode->nodeName;
         point = baseNode->point;
         important = baseNode->important;
     }
 
+    // Every node owns a unique id, so it can not be copied.
+    TravelNode(TravelNode const&) = delete;
+    TravelNode& operator=(TravelNode const&) = delete;
+
+    ~TravelNode() { releaseId(nodeId); }
+
     // Setters
     void setLinked(bool linked1) { linked = linked1; }
     void setPoint(WorldPosition point1) { point = point1; }
 
     // Getters
+    uint32 getNodeId() { return nodeId; }
     std::string const getName() { return nodeName; };
     WorldPosition* getPosition() { return &point; };
     std::unordered_map<TravelNode*, TravelNodePath>* getPaths() { return &paths; }
@@ -319,6 +333,9 @@ public:
     void print(bool printFailed = true);
 
 protected:
+    // Dense id of the node, ids of deleted nodes are reused.
+    uint32 nodeId;
+
     // Logical name of the node
     std::string nodeName;
     // WorldPosition of the node.
@@ -342,6 +359,10 @@ protected:
     // bool transport = false;
     // Entry of transport.
     // uint32 transportId = 0;
+
+private:
+    static uint32 allocateId();
+    static void releaseId(uint32 id);
 };
 
 class PortalNode : public TravelNode
@@ -464,13 +485,47 @@ private:
 class TravelNodeStub
 {
 public:
+    TravelNodeStub() {}
     TravelNodeStub(TravelNode* dataNode1) { dataNode = dataNode1; }
 
-    TravelNode* dataNode;
+    TravelNode* dataNode = nullptr;
     float m_f = 0.0, m_g = 0.0, m_h = 0.0;
     bool open = false, close = false;
     TravelNodeStub* parent = nullptr;
     uint32 currentGold = 0;
+    uint32 heapIndex = 0;  // position in the open list while open
+};
+
+// Scratch space of one A* search, reused by every search on the same thread.
+// Stubs are indexed by node id and belong to the current search only when their stamp matches its generation,
+// so starting a search never clears or allocates anything.
+class TravelNodeSearch
+{
+public:
+    static TravelNodeSearch* instance()
+    {
+        thread_local TravelNodeSearch instance;
+        return &instance;
+    }
+
+    void begin();
+    TravelNodeStub* getStub(TravelNode* node);
+
+    // Open list: binary min-heap on m_f
+    bool empty() { return open.empty(); }
+    void push(TravelNodeStub* stub);
+    TravelNodeStub* pop();
+    void decreased(TravelNodeStub* stub) { siftUp(stub->heapIndex); }
+
+private:
+    void place(uint32 pos, TravelNodeStub* stub);
+    void siftUp(uint32 pos);
+    void siftDown(uint32 pos);
+
+    std::deque<TravelNodeStub> stubs;  // deque keeps stub pointers valid while growing
+    std::vector<uint32> stamps;
+    std::vector<TravelNodeStub*> open;
+    uint32 generation = 0;
 };
 
 // The container of all nodes.
@@ -507,7 +562,8 @@ public:
 
     // Get all nodes
     std::vector<TravelNode*> getNodes() { return m_nodes; }
-    std::vector<TravelNode*> getNodes(WorldPosition pos, float range = -1);
+    // Nodes on the map of pos, nearest first. Only the nearest nodes are returned when a limit is set.
+    std::vector<TravelNode*> getNodes(WorldPosition pos, float range = -1, uint32 limit = 0);
 
     // Find nearest node.
     TravelNode* getNode(TravelNode* sameNode)
@@ -586,7 +642,23 @@ public:
     std::unordered_map<ObjectGuid, std::unordered_map<uint32, TravelNode*>> teleportNodes;
 
 private:
+    // Nodes of one map bucketed in a uniform grid.
+    struct NodeGrid
+    {
+        std::unordered_map<uint64, std::vector<TravelNode*>> cells;
+        std::vector<TravelNode*> nodes;
+        int32 minX = 0, maxX = 0, minY = 0, maxY = 0;
+    };
+
+    static int32 getGridCoord(float coord) { return int32(std::floor(coord / TRAVEL_NODE_GRID_SIZE)); }
+    static uint64 getGridKey(int32 x, int32 y) { return (uint64(uint32(x)) << 32) | uint32(y); }
+
+    // Keep the grids in sync with m_nodes, guarded by m_nMapMtx like m_nodes itself.
+    void indexNode(TravelNode* node);
+    void unindexNode(TravelNode* node);
+
     std::vector<TravelNode*> m_nodes;
+    std::unordered_map<uint32, NodeGrid> m_grids;
 
     std::vector<std::pair<uint32, WorldPosition>> mapOffsets;
 
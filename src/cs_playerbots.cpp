@@ -83,6 +83,14 @@ public:
             return true;
         }
 
+        if (!strcmp(args, "dump"))
+        {
+            if (!sPerformanceMonitor->DumpAsync("perfmon.csv"))
+                handler->PSendSysMessage("A perfmon.csv dump is still being written");
+
+            return true;
+        }
+
         sPerformanceMonitor->PrintStats();
         return true;
     }
@@ -9,6 +9,7 @@
 #include "AiObject.h"
 #include "Common.h"
 #include "Event.h"
+#include "NamedObjectRegistry.h"
 #include "Value.h"
 
 class PlayerbotAI;
@@ -18,10 +19,13 @@ class NextAction
 {
 public:
     NextAction(std::string const name, float relevance = 0.0f)
-        : relevance(relevance), name(name) {}                                  // name after relevance - whipowill
-    NextAction(NextAction const& o) : relevance(o.relevance), name(o.name) {}  // name after relevance - whipowill
+        : relevance(relevance), name(name), id(sNamedObjectRegistry->Intern(name))
+    {
+    }  // name after relevance - whipowill
+    NextAction(NextAction const& o) : relevance(o.relevance), name(o.name), id(o.id) {}
 
     std::string const getName() { return name; }
+    NameId getId() { return id; }
     float getRelevance() { return relevance; }
 
     static uint32 size(NextAction** actions);
@@ -33,6 +37,7 @@ public:
 private:
     float relevance;
     std::string const name;
+    NameId const id;
 };
 
 class Action : public AiNamedObject
@@ -70,12 +75,18 @@ protected:
     float relevance = 0;
 };
 
+// Node templates are owned by a StrategyGraph and shared between bots, so the executing Action is passed in
+// rather than stored on the node.
 class ActionNode
 {
 public:
     ActionNode(std::string const name, NextAction** prerequisites = nullptr, NextAction** alternatives = nullptr,
                NextAction** continuers = nullptr)
-        : name(name), action(nullptr), continuers(continuers), alternatives(alternatives), prerequisites(prerequisites)
+        : name(name),
+          id(sNamedObjectRegistry->Intern(name)),
+          continuers(continuers),
+          alternatives(alternatives),
+          prerequisites(prerequisites)
     {
     }  // reorder arguments - whipowill
 
@@ -86,23 +97,25 @@ public:
         NextAction::destroy(continuers);
     }
 
-    Action* getAction() { return action; }
-    void setAction(Action* action) { this->action = action; }
     std::string const getName() { return name; }
+    NameId getId() { return id; }
 
-    NextAction** getContinuers() { return NextAction::merge(NextAction::clone(continuers), action->getContinuers()); }
-    NextAction** getAlternatives()
+    NextAction** getContinuers(Action* action)
+    {
+        return NextAction::merge(NextAction::clone(continuers), action->getContinuers());
+    }
+    NextAction** getAlternatives(Action* action)
     {
         return NextAction::merge(NextAction::clone(alternatives), action->getAlternatives());
     }
-    NextAction** getPrerequisites()
+    NextAction** getPrerequisites(Action* action)
     {
         return NextAction::merge(NextAction::clone(prerequisites), action->getPrerequisites());
     }
 
 private:
     std::string const name;
-    Action* action;
+    NameId const id;
     NextAction** continuers;
     NextAction** alternatives;
     NextAction** prerequisites;
@@ -111,13 +124,13 @@ private:
 class ActionBasket
 {
 public:
-    ActionBasket(ActionNode* action, float relevance, bool skipPrerequisites, Event event);
+    ActionBasket(ActionNode* action, float relevance, bool skipPrerequisites, Event const& event);
 
     virtual ~ActionBasket(void) {}
 
     float getRelevance() { return relevance; }
     ActionNode* getAction() { return action; }
-    Event getEvent() { return event; }
+    Event const& getEvent() { return event; }
     bool isSkipPrerequisites() { return skipPrerequisites; }
     void AmendRelevance(float k) { relevance *= k; }
     void setRelevance(float relevance) { this->relevance = relevance; }
@@ -127,6 +127,26 @@ UntypedValue* AiObjectContext::GetUntypedValue(std::string const name)
     return valueContexts.GetContextObject(name, botAI);
 }
 
+NameId AiObjectContext::GetValueId(std::string_view name)
+{
+    std::unordered_map<std::string, NameId, ValueNameHash, std::equal_to<>>::const_iterator i = valueIds.find(name);
+    if (i != valueIds.end())
+        return i->second;
+
+    std::string key(name);
+    NameId id = sNamedObjectRegistry->Intern(key);
+    valueIds.emplace(std::move(key), id);
+    return id;
+}
+
+NameId AiObjectContext::GetValueId(std::string_view name, std::string_view param)
+{
+    qualifiedName.assign(name);
+    qualifiedName.append("::");
+    qualifiedName.append(param);
+    return GetValueId(std::string_view(qualifiedName));
+}
+
 std::set<std::string> AiObjectContext::GetValues() { return valueContexts.GetCreated(); }
 
 std::set<std::string> AiObjectContext::GetSupportedStrategies() { return strategyContexts.supports(); }
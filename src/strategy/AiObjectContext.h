@@ -8,9 +8,12 @@
 
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "Common.h"
 #include "NamedObjectContext.h"
+#include "PerformanceMonitor.h"
 #include "PlayerbotAIAware.h"
 #include "Strategy.h"
 #include "Trigger.h"
@@ -30,26 +33,40 @@ public:
     virtual Action* GetAction(std::string const name);
     virtual UntypedValue* GetUntypedValue(std::string const name);
 
+    // handle based fast path, ids come from sNamedObjectRegistry
+    Strategy* GetStrategy(NameId id) { return strategyContexts.GetContextObject(id, botAI); }
+    Trigger* GetTrigger(NameId id) { return triggerContexts.GetContextObject(id, botAI); }
+    Action* GetAction(NameId id) { return actionContexts.GetContextObject(id, botAI); }
+    UntypedValue* GetUntypedValue(NameId id) { return valueContexts.GetContextObject(id, botAI); }
+
+    template <class T>
+    Value<T>* GetValue(NameId id)
+    {
+        return dynamic_cast<Value<T>*>(GetUntypedValue(id));
+    }
+
     template <class T>
-    Value<T>* GetValue(std::string const name)
+    Value<T>* GetValue(std::string_view name)
     {
-        return dynamic_cast<Value<T>*>(GetUntypedValue(name));
+        return GetValue<T>(GetValueId(name));
     }
 
     template <class T>
-    Value<T>* GetValue(std::string const name, std::string const param)
+    Value<T>* GetValue(std::string_view name, std::string_view param)
     {
-        return GetValue<T>((std::string(name) + "::" + param));
+        return GetValue<T>(GetValueId(name, param));
     }
 
     template <class T>
-    Value<T>* GetValue(std::string const name, int32 param)
+    Value<T>* GetValue(std::string_view name, int32 param)
     {
-        std::ostringstream out;
-        out << param;
-        return GetValue<T>(name, out.str());
+        return GetValue<T>(name, std::to_string(param));
     }
 
+    // resolves a value name through the per-context id cache, only new names reach the global registry
+    NameId GetValueId(std::string_view name);
+    NameId GetValueId(std::string_view name, std::string_view param);
+
     std::set<std::string> GetValues();
     std::set<std::string> GetSupportedStrategies();
     std::set<std::string> GetSupportedActions();
@@ -62,13 +79,23 @@ public:
     std::vector<std::string> Save();
     void Load(std::vector<std::string> data);
 
-    std::vector<std::string> performanceStack;
+    PerformanceStack performanceStack;
 
 protected:
     NamedObjectContextList<Strategy> strategyContexts;
     NamedObjectContextList<Action> actionContexts;
     NamedObjectContextList<Trigger> triggerContexts;
     NamedObjectContextList<UntypedValue> valueContexts;
+
+private:
+    struct ValueNameHash
+    {
+        typedef void is_transparent;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+    };
+
+    std::unordered_map<std::string, NameId, ValueNameHash, std::equal_to<>> valueIds;
+    std::string qualifiedName;  // scratch buffer for "name::param" lookups
 };
 
 #endif
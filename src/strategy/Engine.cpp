@@ -11,14 +11,86 @@
 #include "Playerbots.h"
 #include "Queue.h"
 #include "Strategy.h"
+#include "Timer.h"
+
+std::atomic<uint64> Engine::triggerChecks(0);
+std::atomic<uint64> Engine::triggerChecksAvoided(0);
+std::atomic<uint64> Engine::triggerTicks(0);
+
+void TriggerWheel::Reset(uint32 now)
+{
+    for (uint32 i = 0; i < TRIGGER_WHEEL_SLOTS; ++i)
+        slots[i].clear();
+
+    tick = now / TRIGGER_WHEEL_RESOLUTION - 1;
+}
+
+void TriggerWheel::Schedule(uint32 index, uint32 due)
+{
+    // anything already due goes to the next slot advanced to
+    uint32 dueTick = due / TRIGGER_WHEEL_RESOLUTION;
+    if (int32(dueTick - tick) <= 0)
+        dueTick = tick + 1;
+
+    slots[dueTick % TRIGGER_WHEEL_SLOTS].push_back(Entry{index, due});
+}
+
+void TriggerWheel::Advance(uint32 now, std::vector<uint32>& due)
+{
+    uint32 nowTick = now / TRIGGER_WHEEL_RESOLUTION;
+    uint32 steps = std::min<uint32>(nowTick - tick, TRIGGER_WHEEL_SLOTS);
+    std::vector<Entry> later;
+    for (uint32 step = 0; step < steps; ++step)
+    {
+        // intervals longer than a turn of the wheel stay in their slot until their time comes
+        std::vector<Entry>& slot = slots[(nowTick - step) % TRIGGER_WHEEL_SLOTS];
+        for (uint32 i = 0; i < slot.size();)
+        {
+            if (int32(now - slot[i].due) < 0)
+            {
+                // due later within the current slot time, look again on the next advance
+                if (int32(slot[i].due / TRIGGER_WHEEL_RESOLUTION - nowTick) > 0)
+                {
+                    ++i;
+                    continue;
+                }
+
+                later.push_back(slot[i]);
+            }
+            else
+                due.push_back(slot[i].index);
+
+            slot[i] = slot.back();
+            slot.pop_back();
+        }
+    }
+
+    tick = nowTick;
+
+    for (Entry const& entry : later)
+        slots[(nowTick + 1) % TRIGGER_WHEEL_SLOTS].push_back(entry);
+}
+
+bool Engine::SelfState::operator==(SelfState const& other) const
+{
+    return health == other.health && maxHealth == other.maxHealth && mana == other.mana &&
+           maxMana == other.maxMana && rage == other.rage && energy == other.energy &&
+           deathState == other.deathState;
+}
 
 Engine::Engine(PlayerbotAI* botAI, AiObjectContext* factory) : PlayerbotAIAware(botAI), aiObjectContext(factory)
 {
     lastRelevance = 0.0f;
     testMode = false;
+    strategyTypeMask = 0;
+    initialized = false;
+    selfState = SelfState();
+    selfStateVersion = 1;
+    triggersInitialized = false;
+    lastActionRequested = 0;
 }
 
-bool ActionExecutionListeners::Before(Action* action, Event event)
+bool ActionExecutionListeners::Before(Action* action, Event const& event)
 {
     bool result = true;
     for (std::list<ActionExecutionListener*>::iterator i = listeners.begin(); i != listeners.end(); i++)
@@ -29,7 +101,7 @@ bool ActionExecutionListeners::Before(Action* action, Event event)
     return result;
 }
 
-void ActionExecutionListeners::After(Action* action, bool executed, Event event)
+void ActionExecutionListeners::After(Action* action, bool executed, Event const& event)
 {
     for (std::list<ActionExecutionListener*>::iterator i = listeners.begin(); i != listeners.end(); i++)
     {
@@ -37,7 +109,7 @@ void ActionExecutionListeners::After(Action* action, bool executed, Event event)
     }
 }
 
-bool ActionExecutionListeners::OverrideResult(Action* action, bool executed, Event event)
+bool ActionExecutionListeners::OverrideResult(Action* action, bool executed, Event const& event)
 {
     bool result = executed;
     for (std::list<ActionExecutionListener*>::iterator i = listeners.begin(); i != listeners.end(); i++)
@@ -48,7 +120,7 @@ bool ActionExecutionListeners::OverrideResult(Action* action, bool executed, Eve
     return result;
 }
 
-bool ActionExecutionListeners::AllowExecution(Action* action, Event event)
+bool ActionExecutionListeners::AllowExecution(Action* action, Event const& event)
 {
     bool result = true;
     for (std::list<ActionExecutionListener*>::iterator i = listeners.begin(); i != listeners.end(); i++)
@@ -72,6 +144,7 @@ ActionExecutionListeners::~ActionExecutionListeners()
 Engine::~Engine(void)
 {
     Reset();
+    FreeRetiredNodes();
 
     // for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
     // {
@@ -86,24 +159,22 @@ Engine::~Engine(void)
 
 void Engine::Reset()
 {
-    strategyTypeMask = 0;
-    ActionNode* action = nullptr;
-    do
+    while (queue.Pop())
     {
-        action = queue.Pop();
-        if (!action)
-            break;
-
-        delete action;
-    } while (true);
-
-    for (std::vector<TriggerNode*>::iterator i = triggers.begin(); i != triggers.end(); i++)
-    {
-        TriggerNode* trigger = *i;
-        delete trigger;
     }
 
-    triggers.clear();
+    nodeSlots.clear();
+    triggerSlots.clear();
+    pollSlots.clear();
+    externalSlots.clear();
+    firedSlots.clear();
+    triggersInitialized = false;
+    actionNodes.clear();
+    graph.reset();
+
+    // an action may still be running one of these, so they outlive the reset until the next tick
+    retiredNodes.insert(retiredNodes.end(), detachedNodes.begin(), detachedNodes.end());
+    detachedNodes.clear();
 
     for (std::vector<Multiplier*>::iterator i = multipliers.begin(); i != multipliers.end(); i++)
     {
@@ -114,20 +185,26 @@ void Engine::Reset()
     multipliers.clear();
 }
 
+void Engine::FreeRetiredNodes()
+{
+    for (std::vector<ActionNode*>::iterator i = retiredNodes.begin(); i != retiredNodes.end(); i++)
+        delete *i;
+
+    retiredNodes.clear();
+}
+
 void Engine::Init()
 {
     Reset();
+    UpdateStrategyTypeMask();
+
+    graph = sStrategyGraphCache->Get(aiObjectContext, strategies);
+    initialized = true;
 
     for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
-    {
-        Strategy* strategy = i->second;
-        strategyTypeMask |= strategy->GetType();
-        strategy->InitMultipliers(multipliers);
-        strategy->InitTriggers(triggers);
+        i->second->InitMultipliers(multipliers);
 
-        Event emptyEvent;
-        MultiplyAndPush(strategy->getDefaultActions(), 0.0f, false, emptyEvent, "default");
-    }
+    PushDefaultActions();
 
     if (testMode)
     {
@@ -139,6 +216,16 @@ void Engine::Init()
 
 bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
 {
+    // no action of the previous tick is running any more
+    FreeRetiredNodes();
+
+    // strategy changes only mark the engine dirty, a burst of them compiles once here
+    if (!initialized)
+        Init();
+
+    // nodes in the queue belong to the graph, keep it alive even if an action changes strategies
+    std::shared_ptr<StrategyGraph> currentGraph = graph;
+
     LogAction("--- AI Tick ---");
 
     if (sPlayerbotAIConfig->logValuesPerTick)
@@ -202,7 +289,8 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
                     {
                         LogAction("A:%s - PREREQ", action->getName().c_str());
 
-                        if (MultiplyAndPush(actionNode->getPrerequisites(), relevance + 0.02, false, event, "prereq"))
+                        if (MultiplyAndPush(actionNode->getPrerequisites(action), relevance + 0.02, false, event,
+                                            "prereq"))
                         {
                             PushAgain(actionNode, relevance + 0.01, event);
                             continue;
@@ -218,15 +306,14 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
                     if (actionExecuted)
                     {
                         LogAction("A:%s - OK", action->getName().c_str());
-                        MultiplyAndPush(actionNode->getContinuers(), relevance, false, event, "cont");
+                        MultiplyAndPush(actionNode->getContinuers(action), relevance, false, event, "cont");
                         lastRelevance = relevance;
-                        delete actionNode;
                         break;
                     }
                     else
                     {
                         LogAction("A:%s - FAILED", action->getName().c_str());
-                        MultiplyAndPush(actionNode->getAlternatives(), relevance + 0.03, false, event, "alt");
+                        MultiplyAndPush(actionNode->getAlternatives(action), relevance + 0.03, false, event, "alt");
                     }
                 }
                 else
@@ -246,7 +333,7 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
                         botAI->TellMasterNoFacing(out);
                     }
                     LogAction("A:%s - IMPOSSIBLE", action->getName().c_str());
-                    MultiplyAndPush(actionNode->getAlternatives(), relevance + 0.03, false, event, "alt");
+                    MultiplyAndPush(actionNode->getAlternatives(action), relevance + 0.03, false, event, "alt");
                 }
             }
             else
@@ -268,8 +355,6 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
                 lastRelevance = relevance;
                 LogAction("A:%s - USELESS", action->getName().c_str());
             }
-
-            delete actionNode;
         }
     } while (basket && ++iterations <= iterationsPerTick);
 
@@ -291,7 +376,7 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
         if (basket)
         {
             // NOTE: queue.Pop() deletes basket
-            delete queue.Pop();
+            queue.Pop();
         }
     }
     while (basket);
@@ -310,57 +395,56 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
     return actionExecuted;
 }
 
-ActionNode* Engine::CreateActionNode(std::string const name)
+ActionNode* Engine::GetActionNode(NameId id)
 {
-    for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
+    // an action changed strategies mid tick: the shared graph is keyed on the old combination,
+    // so resolve against the current strategies without caching the node anywhere shared
+    if (!initialized)
     {
-        if (ActionNode* node = i->second->GetAction(name))
-            return node;
+        ActionNode* node = StrategyGraph::CreateActionNode(sNamedObjectRegistry->GetName(id), strategies);
+        detachedNodes.push_back(node);
+        return node;
     }
 
-    return new ActionNode(name,
-                          /*P*/ nullptr,
-                          /*A*/ nullptr,
-                          /*C*/ nullptr);
+    std::unordered_map<NameId, ActionNode*>::iterator i = actionNodes.find(id);
+    if (i != actionNodes.end())
+        return i->second;
+
+    return actionNodes[id] = graph->GetActionNode(id, strategies);
 }
 
-bool Engine::MultiplyAndPush(NextAction** actions, float forceRelevance, bool skipPrerequisites, Event event,
+bool Engine::MultiplyAndPush(NextAction** actions, float forceRelevance, bool skipPrerequisites, Event const& event,
                              char const* pushType)
+{
+    bool pushed = PushActions(actions, forceRelevance, skipPrerequisites, event, pushType);
+    NextAction::destroy(actions);
+    return pushed;
+}
+
+bool Engine::PushActions(NextAction** actions, float forceRelevance, bool skipPrerequisites, Event const& event,
+                         char const* pushType)
 {
     bool pushed = false;
     if (actions)
     {
         for (uint32 j = 0; actions[j]; j++)
         {
-            if (NextAction* nextAction = actions[j])
-            {
-                ActionNode* action = CreateActionNode(nextAction->getName());
-                InitializeAction(action);
-
-                float k = nextAction->getRelevance();
-                if (forceRelevance > 0.0f)
-                {
-                    k = forceRelevance;
-                }
+            NextAction* nextAction = actions[j];
 
-                if (k > 0)
-                {
-                    LogAction("PUSH:%s - %f (%s)", action->getName().c_str(), k, pushType);
-                    queue.Push(new ActionBasket(action, k, skipPrerequisites, event));
-                    pushed = true;
-                }
-                else
-                {
-                    delete action;
-                }
+            float k = nextAction->getRelevance();
+            if (forceRelevance > 0.0f)
+            {
+                k = forceRelevance;
+            }
 
-                delete nextAction;
+            if (k > 0)
+            {
+                ActionNode* action = GetActionNode(nextAction->getId());
+                LogAction("PUSH:%s - %f (%s)", action->getName().c_str(), k, pushType);
+                queue.Push(new ActionBasket(action, k, skipPrerequisites, event));
+                pushed = true;
             }
-            else
-                break;
         }
-
-        delete[] actions;
     }
 
     return pushed;
@@ -370,16 +454,16 @@ ActionResult Engine::ExecuteAction(std::string const name, Event event, std::str
 {
     bool result = false;
 
-    ActionNode* actionNode = CreateActionNode(name);
+    if (!initialized)
+        Init();
+
+    ActionNode* actionNode = GetActionNode(sNamedObjectRegistry->Intern(name));
     if (!actionNode)
         return ACTION_RESULT_UNKNOWN;
 
     Action* action = InitializeAction(actionNode);
     if (!action)
-    {
-        delete actionNode;
         return ACTION_RESULT_UNKNOWN;
-    }
 
     if (!qualifier.empty())
     {
@@ -388,24 +472,16 @@ ActionResult Engine::ExecuteAction(std::string const name, Event event, std::str
     }
 
     if (!action->isPossible())
-    {
-        delete actionNode;
         return ACTION_RESULT_IMPOSSIBLE;
-    }
 
     if (!action->isUseful())
-    {
-        delete actionNode;
         return ACTION_RESULT_USELESS;
-    }
 
     action->MakeVerbose();
 
     result = ListenAndExecute(action, event);
     MultiplyAndPush(action->getContinuers(), 0.0f, false, event, "default");
 
-    delete actionNode;
-
     return result ? ACTION_RESULT_OK : ACTION_RESULT_FAILED;
 }
 
@@ -423,7 +499,8 @@ void Engine::addStrategy(std::string const name)
         strategies[strategy->getName()] = strategy;
     }
 
-    Init();
+    UpdateStrategyTypeMask();
+    initialized = false;
 }
 
 void Engine::addStrategies(std::string first, ...)
@@ -452,7 +529,8 @@ bool Engine::removeStrategy(std::string const name)
 
     LogAction("S:-%s", name.c_str());
     strategies.erase(i);
-    Init();
+    UpdateStrategyTypeMask();
+    initialized = false;
 
     return true;
 }
@@ -460,7 +538,15 @@ bool Engine::removeStrategy(std::string const name)
 void Engine::removeAllStrategies()
 {
     strategies.clear();
-    Init();
+    UpdateStrategyTypeMask();
+    initialized = false;
+}
+
+void Engine::UpdateStrategyTypeMask()
+{
+    strategyTypeMask = 0;
+    for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
+        strategyTypeMask |= i->second->GetType();
 }
 
 void Engine::toggleStrategy(std::string const name)
@@ -473,70 +559,190 @@ bool Engine::HasStrategy(std::string const name) { return strategies.find(name)
 
 void Engine::ProcessTriggers(bool minimal)
 {
-    std::unordered_map<Trigger*, Event> fires;
-    for (std::vector<TriggerNode*>::iterator i = triggers.begin(); i != triggers.end(); i++)
+    if (!triggersInitialized)
+        InitTriggers();
+
+    UpdateSelfState();
+
+    uint32 checks = 0;
+    if (testMode)
     {
-        TriggerNode* node = *i;
-        if (!node)
-            continue;
+        for (uint32 i = 0; i < triggerSlots.size(); ++i)
+            checks += CheckTrigger(i, minimal);
+    }
+    else
+    {
+        for (uint32 i = 0; i < pollSlots.size(); ++i)
+            checks += CheckTrigger(pollSlots[i], minimal);
 
-        Trigger* trigger = node->getTrigger();
-        if (!trigger)
+        // packet and command triggers have nothing to report until an external event arrives
+        for (uint32 i = 0; i < externalSlots.size(); ++i)
         {
-            trigger = aiObjectContext->GetTrigger(node->getName());
-            node->setTrigger(trigger);
+            if (triggerSlots[externalSlots[i]].trigger->IsTriggered())
+                checks += CheckTrigger(externalSlots[i], minimal);
         }
 
-        if (!trigger)
-            continue;
-
-        if (fires.find(trigger) != fires.end())
-            continue;
-
-        if (testMode || trigger->needCheck())
+        dueSlots.clear();
+        triggerWheel.Advance(getMSTime(), dueSlots);
+        for (uint32 i = 0; i < dueSlots.size(); ++i)
         {
-            if (minimal && node->getFirstRelevance() < 100)
+            uint32 index = dueSlots[i];
+            if (index >= triggerSlots.size())
                 continue;
 
-            PerformanceMonitorOperation* pmo =
-                sPerformanceMonitor->start(PERF_MON_TRIGGER, trigger->getName(), &aiObjectContext->performanceStack);
-            Event event = trigger->Check();
-            if (pmo)
-                pmo->finish();
+            // engines of a bot share its triggers, another one may have checked it in the meantime
+            Trigger* trigger = triggerSlots[index].trigger;
+            if (trigger->needCheck())
+                checks += CheckTrigger(index, minimal);
 
-            if (!event)
+            triggerWheel.Schedule(index, trigger->GetNextCheckTime());
+        }
+    }
+
+    triggerChecks.fetch_add(checks, std::memory_order_relaxed);
+    triggerChecksAvoided.fetch_add(triggerSlots.size() - std::min<uint32>(checks, triggerSlots.size()),
+                                   std::memory_order_relaxed);
+    triggerTicks.fetch_add(1, std::memory_order_relaxed);
+
+    if (!firedSlots.empty())
+    {
+        // handlers are pushed in node order, a trigger shared by several nodes pushes the handlers of each
+        std::vector<TriggerNode*> const& nodes = graph->GetTriggers();
+        for (uint32 i = 0; i < nodes.size() && i < nodeSlots.size(); ++i)
+        {
+            uint32 slot = nodeSlots[i];
+            if (!slot || !triggerSlots[slot - 1].event)
                 continue;
 
-            fires[trigger] = event;
-            LogAction("T:%s", trigger->getName().c_str());
+            TriggerSlot& fired = triggerSlots[slot - 1];
+            MultiplyAndPush(nodes[i]->getHandlers(fired.trigger), 0.0f, false, fired.event, "trigger");
         }
+
+        for (uint32 i = 0; i < firedSlots.size(); ++i)
+            triggerSlots[firedSlots[i]].event = Event();
+
+        firedSlots.clear();
     }
 
-    for (std::vector<TriggerNode*>::iterator i = triggers.begin(); i != triggers.end(); i++)
+    for (uint32 i = 0; i < externalSlots.size(); ++i)
+        triggerSlots[externalSlots[i]].trigger->Reset();
+}
+
+void Engine::InitTriggers()
+{
+    std::vector<TriggerNode*> const& nodes = graph->GetTriggers();
+    nodeSlots.assign(nodes.size(), 0);
+
+    std::unordered_map<Trigger*, uint32> slots;
+    for (uint32 i = 0; i < nodes.size(); ++i)
     {
-        TriggerNode* node = *i;
-        Trigger* trigger = node->getTrigger();
-        if (fires.find(trigger) == fires.end())
+        TriggerNode* node = nodes[i];
+        if (!node)
+            continue;
+
+        Trigger* trigger = aiObjectContext->GetTrigger(node->getId());
+        if (!trigger)
             continue;
 
-        Event event = fires[trigger];
-        MultiplyAndPush(node->getHandlers(), 0.0f, false, event, "trigger");
+        std::pair<std::unordered_map<Trigger*, uint32>::iterator, bool> inserted =
+            slots.emplace(trigger, triggerSlots.size());
+        if (inserted.second)
+        {
+            TriggerSlot slot;
+            slot.trigger = trigger;
+            slot.input = trigger->GetInput();
+            slot.relevance = node->getFirstRelevance();
+            slot.checkedState = 0;
+            triggerSlots.push_back(slot);
+        }
+        else
+        {
+            TriggerSlot& slot = triggerSlots[inserted.first->second];
+            slot.relevance = std::max(slot.relevance, node->getFirstRelevance());
+        }
+
+        nodeSlots[i] = inserted.first->second + 1;
     }
 
-    for (std::vector<TriggerNode*>::iterator i = triggers.begin(); i != triggers.end(); i++)
+    triggerWheel.Reset(getMSTime());
+    for (uint32 i = 0; i < triggerSlots.size(); ++i)
     {
-        if (Trigger* trigger = (*i)->getTrigger())
-            trigger->Reset();
+        Trigger* trigger = triggerSlots[i].trigger;
+        if (triggerSlots[i].input == TRIGGER_INPUT_EXTERNAL)
+            externalSlots.push_back(i);
+        else if (trigger->HasInterval())
+            triggerWheel.Schedule(i, trigger->GetNextCheckTime());
+        else
+            pollSlots.push_back(i);
     }
+
+    triggersInitialized = true;
+}
+
+bool Engine::CheckTrigger(uint32 index, bool minimal)
+{
+    if (index >= triggerSlots.size())
+        return false;
+
+    TriggerSlot& slot = triggerSlots[index];
+    if (minimal && slot.relevance < 100)
+        return false;
+
+    // inactive last time and nothing it reads has changed since
+    if (slot.input == TRIGGER_INPUT_SELF_STATE && slot.checkedState == selfStateVersion && !testMode)
+        return false;
+
+    Trigger* trigger = slot.trigger;
+    PerformanceMonitorOperation* pmo =
+        sPerformanceMonitor->start(PERF_MON_TRIGGER, trigger->getName(), &aiObjectContext->performanceStack);
+    Event event = trigger->Check();
+    if (pmo)
+        pmo->finish();
+
+    // a check that changed strategies has already dropped the slots
+    if (index >= triggerSlots.size())
+        return true;
+
+    if (!event)
+    {
+        triggerSlots[index].checkedState = selfStateVersion;
+        return true;
+    }
+
+    triggerSlots[index].checkedState = 0;
+    triggerSlots[index].event = std::move(event);
+    firedSlots.push_back(index);
+    LogAction("T:%s", trigger->getName().c_str());
+    return true;
+}
+
+void Engine::UpdateSelfState()
+{
+    Player* bot = botAI->GetBot();
+
+    SelfState state;
+    state.health = bot->GetHealth();
+    state.maxHealth = bot->GetMaxHealth();
+    state.mana = bot->GetPower(POWER_MANA);
+    state.maxMana = bot->GetMaxPower(POWER_MANA);
+    state.rage = bot->GetPower(POWER_RAGE);
+    state.energy = bot->GetPower(POWER_ENERGY);
+    state.deathState = uint8(bot->getDeathState());
+    if (state == selfState)
+        return;
+
+    selfState = state;
+    if (!++selfStateVersion)
+        selfStateVersion = 1;
 }
 
 void Engine::PushDefaultActions()
 {
-    for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
+    std::vector<NextAction**> const& defaultActions = graph->GetDefaultActions();
+    for (std::vector<NextAction**>::const_iterator i = defaultActions.begin(); i != defaultActions.end(); i++)
     {
-        Strategy* strategy = i->second;
         Event emptyEvent;
-        MultiplyAndPush(strategy->getDefaultActions(), 0.0f, false, emptyEvent, "default");
+        PushActions(*i, 0.0f, false, emptyEvent, "default");
     }
 }
 
@@ -567,13 +773,12 @@ std::vector<std::string> Engine::GetStrategies()
     return result;
 }
 
-void Engine::PushAgain(ActionNode* actionNode, float relevance, Event event)
+void Engine::PushAgain(ActionNode* actionNode, float relevance, Event const& event)
 {
     NextAction** nextAction = new NextAction*[2];
     nextAction[0] = new NextAction(actionNode->getName(), relevance);
     nextAction[1] = nullptr;
     MultiplyAndPush(nextAction, relevance, true, event, "again");
-    delete actionNode;
 }
 
 bool Engine::ContainsStrategy(StrategyType type)
@@ -586,19 +791,9 @@ bool Engine::ContainsStrategy(StrategyType type)
     return false;
 }
 
-Action* Engine::InitializeAction(ActionNode* actionNode)
-{
-    Action* action = actionNode->getAction();
-    if (!action)
-    {
-        action = aiObjectContext->GetAction(actionNode->getName());
-        actionNode->setAction(action);
-    }
+Action* Engine::InitializeAction(ActionNode* actionNode) { return aiObjectContext->GetAction(actionNode->getId()); }
 
-    return action;
-}
-
-bool Engine::ListenAndExecute(Action* action, Event event)
+bool Engine::ListenAndExecute(Action* action, Event const& event)
 {
     bool actionExecuted = false;
 
@@ -631,17 +826,29 @@ bool Engine::ListenAndExecute(Action* action, Event event)
     return actionExecuted;
 }
 
+std::string const Engine::GetLastAction()
+{
+    lastActionRequested = getMSTime();
+    return lastAction;
+}
+
 void Engine::LogAction(char const* format, ...)
 {
     Player* bot = botAI->GetBot();
     if (sPlayerbotAIConfig->logInGroupOnly && (!bot->GetGroup() || !botAI->HasRealPlayerMaster()) && !testMode)
         return;
 
+    // formatting is skipped unless the line goes to the test log, the debug log or a recent "action" query
+    bool recordLastAction =
+        lastActionRequested && getMSTimeDiff(lastActionRequested, getMSTime()) < ENGINE_LAST_ACTION_TIME;
+    if (!testMode && !recordLastAction && !sLog->ShouldLog("playerbots", LOG_LEVEL_DEBUG))
+        return;
+
     char buf[1024];
 
     va_list ap;
     va_start(ap, format);
-    vsprintf(buf, format, ap);
+    vsnprintf(buf, sizeof(buf), format, ap);
     va_end(ap);
 
     lastAction += "|";
@@ -6,12 +6,15 @@
 #ifndef _PLAYERBOT_ENGINE_H
 #define _PLAYERBOT_ENGINE_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 
 #include "Multiplier.h"
 #include "PlayerbotAIAware.h"
 #include "Queue.h"
 #include "Strategy.h"
+#include "StrategyGraph.h"
 #include "Trigger.h"
 
 class Action;
@@ -21,6 +24,11 @@ class Event;
 class NextAction;
 class PlayerbotAI;
 
+#define TRIGGER_WHEEL_SLOTS 64
+#define TRIGGER_WHEEL_RESOLUTION 100
+// how long action logging stays on for the last action shown by the "action" command
+#define ENGINE_LAST_ACTION_TIME 300000
+
 enum ActionResult
 {
     ACTION_RESULT_UNKNOWN,
@@ -35,10 +43,10 @@ class ActionExecutionListener
 public:
     virtual ~ActionExecutionListener(){};
 
-    virtual bool Before(Action* action, Event event) = 0;
-    virtual bool AllowExecution(Action* action, Event event) = 0;
-    virtual void After(Action* action, bool executed, Event event) = 0;
-    virtual bool OverrideResult(Action* action, bool executed, Event event) = 0;
+    virtual bool Before(Action* action, Event const& event) = 0;
+    virtual bool AllowExecution(Action* action, Event const& event) = 0;
+    virtual void After(Action* action, bool executed, Event const& event) = 0;
+    virtual bool OverrideResult(Action* action, bool executed, Event const& event) = 0;
 };
 
 class ActionExecutionListeners : public ActionExecutionListener
@@ -46,10 +54,10 @@ class ActionExecutionListeners : public ActionExecutionListener
 public:
     virtual ~ActionExecutionListeners();
 
-    bool Before(Action* action, Event event) override;
-    bool AllowExecution(Action* action, Event event) override;
-    void After(Action* action, bool executed, Event event) override;
-    bool OverrideResult(Action* action, bool executed, Event event) override;
+    bool Before(Action* action, Event const& event) override;
+    bool AllowExecution(Action* action, Event const& event) override;
+    void After(Action* action, bool executed, Event const& event) override;
+    bool OverrideResult(Action* action, bool executed, Event const& event) override;
 
     void Add(ActionExecutionListener* listener) { listeners.push_back(listener); }
 
@@ -59,6 +67,27 @@ private:
     std::list<ActionExecutionListener*> listeners;
 };
 
+// Triggers with a check interval, bucketed by the time they are due so an engine only looks at due ones
+class TriggerWheel
+{
+public:
+    TriggerWheel() : tick(0) {}
+
+    void Reset(uint32 now);
+    void Schedule(uint32 index, uint32 due);
+    void Advance(uint32 now, std::vector<uint32>& due);
+
+private:
+    struct Entry
+    {
+        uint32 index;
+        uint32 due;
+    };
+
+    std::vector<Entry> slots[TRIGGER_WHEEL_SLOTS];
+    uint32 tick;  // last slot time advanced to
+};
+
 class Engine : public PlayerbotAIAware
 {
 public:
@@ -75,7 +104,7 @@ public:
     std::vector<std::string> GetStrategies();
     bool ContainsStrategy(StrategyType type);
     void ChangeStrategy(std::string const names);
-    std::string const GetLastAction() { return lastAction; }
+    std::string const GetLastAction();
 
     virtual bool DoNextAction(Unit*, uint32 depth = 0, bool minimal = false);
     ActionResult ExecuteAction(std::string const name, Event event = Event(), std::string const qualifier = "");
@@ -88,16 +117,46 @@ public:
 
     bool testMode;
 
+    // trigger checks done and skipped by all engines, and the ticks they were counted over
+    static std::atomic<uint64> triggerChecks;
+    static std::atomic<uint64> triggerChecksAvoided;
+    static std::atomic<uint64> triggerTicks;
+
 private:
-    bool MultiplyAndPush(NextAction** actions, float forceRelevance, bool skipPrerequisites, Event event,
+    // one per distinct trigger of the graph
+    struct TriggerSlot
+    {
+        Trigger* trigger;
+        TriggerInput input;
+        float relevance;       // highest first relevance of its nodes, for minimal ticks
+        uint32 checkedState;   // selfStateVersion when it was last found inactive
+        Event event;           // fired this tick
+    };
+
+    struct SelfState
+    {
+        uint32 health, maxHealth, mana, maxMana, rage, energy;
+        uint8 deathState;
+
+        bool operator==(SelfState const& other) const;
+    };
+
+    bool MultiplyAndPush(NextAction** actions, float forceRelevance, bool skipPrerequisites, Event const& event,
                          const char* pushType);
+    bool PushActions(NextAction** actions, float forceRelevance, bool skipPrerequisites, Event const& event,
+                     const char* pushType);
     void Reset();
+    void FreeRetiredNodes();
+    void UpdateStrategyTypeMask();
     void ProcessTriggers(bool minimal);
+    void InitTriggers();
+    bool CheckTrigger(uint32 index, bool minimal);
+    void UpdateSelfState();
     void PushDefaultActions();
-    void PushAgain(ActionNode* actionNode, float relevance, Event event);
-    ActionNode* CreateActionNode(std::string const name);
+    void PushAgain(ActionNode* actionNode, float relevance, Event const& event);
+    ActionNode* GetActionNode(NameId id);
     Action* InitializeAction(ActionNode* actionNode);
-    bool ListenAndExecute(Action* action, Event event);
+    bool ListenAndExecute(Action* action, Event const& event);
 
     void LogAction(char const* format, ...);
     void LogValues();
@@ -106,13 +165,28 @@ private:
 
 protected:
     Queue queue;
-    std::vector<TriggerNode*> triggers;
+    std::shared_ptr<StrategyGraph> graph;
+    std::vector<uint32> nodeSlots;  // slot + 1 of each of graph->GetTriggers(), 0 if it has no trigger
+    std::vector<TriggerSlot> triggerSlots;
+    std::vector<uint32> pollSlots;
+    std::vector<uint32> externalSlots;
+    std::vector<uint32> dueSlots;
+    std::vector<uint32> firedSlots;
+    TriggerWheel triggerWheel;
+    SelfState selfState;
+    uint32 selfStateVersion;
+    bool triggersInitialized;
+    std::unordered_map<NameId, ActionNode*> actionNodes;
+    std::vector<ActionNode*> detachedNodes;  // built while strategies differ from the graph, retired on Init
+    std::vector<ActionNode*> retiredNodes;   // freed at the start of the next tick
     std::vector<Multiplier*> multipliers;
     AiObjectContext* aiObjectContext;
     std::map<std::string, Strategy*> strategies;
     float lastRelevance;
     std::string lastAction;
+    uint32 lastActionRequested;
     uint32 strategyTypeMask;
+    bool initialized;
 };
 
 #endif
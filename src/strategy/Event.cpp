@@ -7,21 +7,56 @@
 
 #include "Playerbots.h"
 
-Event::Event(std::string const source, ObjectGuid object, Player* owner) : source(source), owner(owner)
+Event::Event(std::string const source)
+    : source(source.empty() ? 0 : sNamedObjectRegistry->Intern(source)), owner(nullptr), payload(nullptr)
 {
+}
+
+Event::Event(std::string const source, std::string const param, Player* owner)
+    : source(source.empty() ? 0 : sNamedObjectRegistry->Intern(source)),
+      owner(owner),
+      payload(param.empty() ? nullptr : new EventPayload(param))
+{
+}
+
+Event::Event(std::string const source, WorldPacket const& packet, Player* owner)
+    : source(source.empty() ? 0 : sNamedObjectRegistry->Intern(source)), owner(owner), payload(new EventPayload(packet))
+{
+}
+
+Event::Event(std::string const source, ObjectGuid object, Player* owner)
+    : source(source.empty() ? 0 : sNamedObjectRegistry->Intern(source)), owner(owner), payload(nullptr)
+{
+    WorldPacket packet;
     packet << object;
+    payload = new EventPayload(packet);
 }
 
-ObjectGuid Event::getObject()
+void Event::Release()
 {
-    if (packet.empty())
-        return ObjectGuid::Empty;
+    if (payload && payload->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete payload;
 
-    WorldPacket p(packet);
-    p.rpos(0);
+    payload = nullptr;
+}
+
+std::string const& Event::getParam() const
+{
+    static std::string const empty;
+    return payload ? payload->param : empty;
+}
+
+WorldPacket const& Event::getPacket() const
+{
+    static WorldPacket const empty;
+    return payload && payload->packet ? *payload->packet : empty;
+}
 
-    ObjectGuid guid;
-    p >> guid;
+ObjectGuid Event::getObject() const
+{
+    WorldPacket const& packet = getPacket();
+    if (packet.empty())
+        return ObjectGuid::Empty;
 
-    return guid;
+    return ObjectGuid(packet.read<uint64>(0));
 }
@@ -6,40 +6,70 @@
 #ifndef _PLAYERBOT_EVENT_H
 #define _PLAYERBOT_EVENT_H
 
+#include <atomic>
+#include <memory>
+
+#include "NamedObjectRegistry.h"
 #include "WorldPacket.h"
 
 class ObjectGuid;
 class Player;
 
+// Param and packet of an event, shared by all copies of it and never changed once created
+struct EventPayload
+{
+    EventPayload(std::string const& param) : refs(1), param(param) {}
+    EventPayload(WorldPacket const& packet) : refs(1), packet(std::make_unique<WorldPacket>(packet)) {}
+
+    std::atomic<uint32> refs;
+    std::string const param;
+    std::unique_ptr<WorldPacket const> packet;
+};
+
+// Copies of an event share one payload, so passing events through the engine never copies strings or packets
 class Event
 {
 public:
-    Event(Event const& other) : source(other.source), param(other.param), packet(other.packet), owner(other.owner) {}
-    Event() {}
-    Event(std::string const source) : source(source) {}
-    Event(std::string const source, std::string const param, Player* owner = nullptr)
-        : source(source), param(param), owner(owner)
+    Event() : source(0), owner(nullptr), payload(nullptr) {}
+    Event(Event const& other) : source(other.source), owner(other.owner), payload(other.payload)
     {
+        if (payload)
+            payload->refs.fetch_add(1, std::memory_order_relaxed);
     }
-    Event(std::string const source, WorldPacket& packet, Player* owner = nullptr)
-        : source(source), packet(packet), owner(owner)
+    Event(Event&& other) noexcept : source(other.source), owner(other.owner), payload(other.payload)
     {
+        other.payload = nullptr;
     }
+    explicit Event(NameId source, Player* owner = nullptr) : source(source), owner(owner), payload(nullptr) {}
+    Event(std::string const source);
+    Event(std::string const source, std::string const param, Player* owner = nullptr);
+    Event(std::string const source, WorldPacket const& packet, Player* owner = nullptr);
     Event(std::string const source, ObjectGuid object, Player* owner = nullptr);
-    virtual ~Event() {}
-
-    std::string const GetSource() { return source; }
-    std::string const getParam() { return param; }
-    WorldPacket& getPacket() { return packet; }
-    ObjectGuid getObject();
-    Player* getOwner() { return owner; }
-    bool operator!() const { return source.empty(); }
-
-protected:
-    std::string source;
-    std::string param;
-    WorldPacket packet;
-    Player* owner = nullptr;
+    ~Event() { Release(); }
+
+    Event& operator=(Event other)
+    {
+        std::swap(source, other.source);
+        std::swap(owner, other.owner);
+        std::swap(payload, other.payload);
+        return *this;
+    }
+
+    std::string const& GetSource() const { return sNamedObjectRegistry->GetName(source); }
+    NameId GetSourceId() const { return source; }
+    std::string const& getParam() const;
+    // Shared by every copy of the event, readers that parse it copy it to get their own read position
+    WorldPacket const& getPacket() const;
+    ObjectGuid getObject() const;
+    Player* getOwner() const { return owner; }
+    bool operator!() const { return !source; }
+
+private:
+    void Release();
+
+    NameId source;
+    Player* owner;
+    EventPayload* payload;
 };
 
 #endif
@@ -51,8 +51,7 @@ void ExternalEventHelper::HandlePacket(std::map<uint16, std::string>& handlers,
     if (!trigger)
         return;
 
-    WorldPacket p(packet);
-    trigger->ExternalEvent(p, owner);
+    trigger->ExternalEvent(packet, owner);
 }
 
 bool ExternalEventHelper::HandleCommand(std::string const name, std::string const param, Player* owner)
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "Common.h"
+#include "NamedObjectRegistry.h"
 
 class PlayerbotAI;
 
@@ -92,17 +93,20 @@ public:
 
     virtual ~NamedObjectContext() { Clear(); }
 
-    T* create(std::string const name, PlayerbotAI* botAI)
+    T* create(std::string const name, PlayerbotAI* botAI) { return create(sNamedObjectRegistry->Intern(name), botAI); }
+
+    virtual T* create(NameId id, PlayerbotAI* botAI)
     {
-        if (created.find(name) == created.end())
-            return created[name] = NamedObjectFactory<T>::create(name, botAI);
+        typename std::unordered_map<NameId, T*>::iterator i = created.find(id);
+        if (i != created.end())
+            return i->second;
 
-        return created[name];
+        return created[id] = NamedObjectFactory<T>::create(sNamedObjectRegistry->GetName(id), botAI);
     }
 
     void Clear()
     {
-        for (typename std::unordered_map<std::string, T*>::iterator i = created.begin(); i != created.end(); i++)
+        for (typename std::unordered_map<NameId, T*>::iterator i = created.begin(); i != created.end(); i++)
         {
             if (i->second)
                 delete i->second;
@@ -113,7 +117,7 @@ public:
 
     void Update()
     {
-        for (typename std::unordered_map<std::string, T*>::iterator i = created.begin(); i != created.end(); i++)
+        for (typename std::unordered_map<NameId, T*>::iterator i = created.begin(); i != created.end(); i++)
         {
             if (i->second)
                 i->second->Update();
@@ -122,7 +126,7 @@ public:
 
     void Reset()
     {
-        for (typename std::unordered_map<std::string, T*>::iterator i = created.begin(); i != created.end(); i++)
+        for (typename std::unordered_map<NameId, T*>::iterator i = created.begin(); i != created.end(); i++)
         {
             if (i->second)
                 i->second->Reset();
@@ -132,17 +136,17 @@ public:
     bool IsShared() { return shared; }
     bool IsSupportsSiblings() { return supportsSiblings; }
 
-    std::set<std::string> GetCreated()
+    virtual std::set<std::string> GetCreated()
     {
         std::set<std::string> keys;
-        for (typename std::unordered_map<std::string, T*>::iterator it = created.begin(); it != created.end(); it++)
-            keys.insert(it->first);
+        for (typename std::unordered_map<NameId, T*>::iterator it = created.begin(); it != created.end(); it++)
+            keys.insert(sNamedObjectRegistry->GetName(it->first));
 
         return keys;
     }
 
 protected:
-    std::unordered_map<std::string, T*> created;
+    std::unordered_map<NameId, T*> created;
     bool shared;
     bool supportsSiblings;
 };
@@ -161,16 +165,30 @@ public:
         }
     }
 
-    void Add(NamedObjectContext<T>* context) { contexts.push_back(context); }
+    void Add(NamedObjectContext<T>* context)
+    {
+        contexts.push_back(context);
+        resolved.clear();
+    }
 
     T* GetContextObject(std::string const name, PlayerbotAI* botAI)
     {
+        return GetContextObject(sNamedObjectRegistry->Intern(name), botAI);
+    }
+
+    T* GetContextObject(NameId id, PlayerbotAI* botAI)
+    {
+        typename std::unordered_map<NameId, T*>::iterator found = resolved.find(id);
+        if (found != resolved.end())
+            return found->second;
+
         for (typename std::vector<NamedObjectContext<T>*>::iterator i = contexts.begin(); i != contexts.end(); i++)
         {
-            if (T* object = (*i)->create(name, botAI))
-                return object;
+            if (T* object = (*i)->create(id, botAI))
+                return resolved[id] = object;
         }
 
+        // misses are not remembered, a context added or rebuilt later may still answer the name
         return nullptr;
     }
 
@@ -187,7 +205,8 @@ public:
     {
         for (typename std::vector<NamedObjectContext<T>*>::iterator i = contexts.begin(); i != contexts.end(); i++)
         {
-            (*i)->Reset();
+            if (!(*i)->IsShared())
+                (*i)->Reset();
         }
     }
 
@@ -240,6 +259,7 @@ public:
 
 private:
     std::vector<NamedObjectContext<T>*> contexts;
+    std::unordered_map<NameId, T*> resolved;  // which context answered each name, so later lookups skip the walk
 };
 
 template <class T>
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "NamedObjectRegistry.h"
+
+#include <mutex>
+
+NameId NamedObjectRegistry::Intern(std::string const& name)
+{
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        std::unordered_map<std::string, NameId>::const_iterator i = ids.find(name);
+        if (i != ids.end())
+            return i->second;
+    }
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+    std::unordered_map<std::string, NameId>::const_iterator i = ids.find(name);
+    if (i != ids.end())
+        return i->second;
+
+    NameId id = names.size();
+    names.push_back(name);
+    ids[name] = id;
+    return id;
+}
+
+NameId NamedObjectRegistry::Intern(std::string const& name, std::string const& qualifier)
+{
+    // qualified lookups happen on every AI_VALUE2, so reuse one buffer per thread instead of concatenating
+    thread_local std::string qualified;
+    qualified.assign(name);
+    qualified.append("::");
+    qualified.append(qualifier);
+    return Intern(qualified);
+}
+
+NameId NamedObjectRegistry::Find(std::string const& name)
+{
+    std::shared_lock<std::shared_mutex> guard(lock);
+    std::unordered_map<std::string, NameId>::const_iterator i = ids.find(name);
+    return i != ids.end() ? i->second : 0;
+}
+
+std::string const& NamedObjectRegistry::GetName(NameId id)
+{
+    std::shared_lock<std::shared_mutex> guard(lock);
+    return id < names.size() ? names[id] : names[0];
+}
+
+uint32 NamedObjectRegistry::Size()
+{
+    std::shared_lock<std::shared_mutex> guard(lock);
+    return names.size();
+}
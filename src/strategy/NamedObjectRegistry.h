@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_NAMEDOBJECTREGISTRY_H
+#define _PLAYERBOT_NAMEDOBJECTREGISTRY_H
+
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Common.h"
+
+// Stable integer handle for a strategy/action/trigger/value name. 0 is never handed out.
+typedef uint32 NameId;
+
+// Process-wide name interning table. Ids start at 1 and are never recycled, so they are stable keys
+// for hashing and comparison. The id space grows with every distinct name (including qualified ones),
+// so do not use ids to index per-bot arrays.
+class NamedObjectRegistry
+{
+public:
+    NamedObjectRegistry() { names.emplace_back(); }
+    virtual ~NamedObjectRegistry() {}
+    static NamedObjectRegistry* instance()
+    {
+        static NamedObjectRegistry instance;
+        return &instance;
+    }
+
+public:
+    NameId Intern(std::string const& name);
+    NameId Intern(std::string const& name, std::string const& qualifier);
+    NameId Find(std::string const& name);
+    std::string const& GetName(NameId id);
+    uint32 Size();
+
+private:
+    std::unordered_map<std::string, NameId> ids;
+    std::deque<std::string> names;
+    std::shared_mutex lock;
+};
+
+#define sNamedObjectRegistry NamedObjectRegistry::instance()
+
+#endif
@@ -11,94 +11,146 @@
 
 void Queue::Push(ActionBasket* action)
 {
-    if (action)
+    if (!action)
+        return;
+
+    NameId id = action->getAction()->getId();
+    std::unordered_map<NameId, uint32>::iterator slot = slots.find(id);
+    if (slot != slots.end())
     {
-        for (std::list<ActionBasket*>::iterator iter = actions.begin(); iter != actions.end(); iter++)
+        uint32 pos = slot->second;
+        ActionBasket* basket = heap[pos].basket;
+        if (basket->getRelevance() < action->getRelevance())
         {
-            ActionBasket* basket = *iter;
-            if (action->getAction()->getName() == basket->getAction()->getName())
-            {
-                if (basket->getRelevance() < action->getRelevance())
-                    basket->setRelevance(action->getRelevance());
-
-                if (ActionNode* actionNode = action->getAction())
-                    delete actionNode;
-
-                delete action;
-
-                return;
-            }
+            basket->setRelevance(action->getRelevance());
+            SiftUp(pos);
         }
 
-        actions.push_back(action);
+        delete action;
+
+        return;
     }
+
+    heap.push_back(Entry{action, id, pushed++});
+    slots[id] = heap.size() - 1;
+    SiftUp(heap.size() - 1);
 }
 
 ActionNode* Queue::Pop()
 {
-    float max = -1;
-    ActionBasket* selection = nullptr;
+    if (heap.empty())
+        return nullptr;
+
+    ActionBasket* selection = heap[0].basket;
+    RemoveAt(0);
+
+    ActionNode* action = selection->getAction();
+    delete selection;
+    return action;
+}
+
+ActionBasket* Queue::Peek() { return heap.empty() ? nullptr : heap[0].basket; }
+
+uint32 Queue::Size() { return heap.size(); }
 
-    for (std::list<ActionBasket*>::iterator iter = actions.begin(); iter != actions.end(); iter++)
+void Queue::RemoveExpired()
+{
+    if (!sPlayerbotAIConfig->expireActionTime)
+        return;
+
+    bool removed = false;
+    for (uint32 i = 0; i < heap.size();)
     {
-        ActionBasket* basket = *iter;
-        if (basket->getRelevance() > max)
+        ActionBasket* basket = heap[i].basket;
+        if (!basket->isExpired(sPlayerbotAIConfig->expireActionTime))
         {
-            max = basket->getRelevance();
-            selection = basket;
+            ++i;
+            continue;
         }
-    }
 
-    if (selection != nullptr)
-    {
-        ActionNode* action = selection->getAction();
-        actions.remove(selection);
-        delete selection;
-        return action;
+        slots.erase(heap[i].id);
+        heap[i] = heap.back();
+        heap.pop_back();
+        removed = true;
+
+        delete basket;
     }
 
-    return nullptr;
+    if (!removed)
+        return;
+
+    for (uint32 i = 0; i < heap.size(); ++i)
+        slots[heap[i].id] = i;
+
+    for (uint32 i = heap.size() / 2; i-- > 0;)
+        SiftDown(i);
 }
 
-ActionBasket* Queue::Peek()
+bool Queue::Before(Entry const& left, Entry const& right) const
 {
-    float max = -1;
-    ActionBasket* selection = nullptr;
-    for (std::list<ActionBasket*>::iterator iter = actions.begin(); iter != actions.end(); iter++)
-    {
-        ActionBasket* basket = *iter;
-        if (basket->getRelevance() > max)
-        {
-            max = basket->getRelevance();
-            selection = basket;
-        }
-    }
+    float leftRelevance = left.basket->getRelevance();
+    float rightRelevance = right.basket->getRelevance();
+    if (leftRelevance != rightRelevance)
+        return leftRelevance > rightRelevance;
 
-    return selection;
+    return left.order < right.order;
 }
 
-uint32 Queue::Size() { return actions.size(); }
+void Queue::Place(uint32 pos, Entry const& entry)
+{
+    heap[pos] = entry;
+    slots[entry.id] = pos;
+}
 
-void Queue::RemoveExpired()
+void Queue::SiftUp(uint32 pos)
 {
-    std::list<ActionBasket*> expired;
-    for (std::list<ActionBasket*>::iterator iter = actions.begin(); iter != actions.end(); iter++)
+    Entry entry = heap[pos];
+    while (pos > 0)
     {
-        ActionBasket* basket = *iter;
-        if (sPlayerbotAIConfig->expireActionTime && basket->isExpired(sPlayerbotAIConfig->expireActionTime))
-            expired.push_back(basket);
+        uint32 parent = (pos - 1) / 2;
+        if (!Before(entry, heap[parent]))
+            break;
+
+        Place(pos, heap[parent]);
+        pos = parent;
     }
 
-    for (std::list<ActionBasket*>::iterator iter = expired.begin(); iter != expired.end(); iter++)
+    Place(pos, entry);
+}
+
+void Queue::SiftDown(uint32 pos)
+{
+    uint32 size = heap.size();
+    Entry entry = heap[pos];
+    while (true)
     {
-        ActionBasket* basket = *iter;
-        actions.remove(basket);
+        uint32 child = pos * 2 + 1;
+        if (child >= size)
+            break;
 
-        if (ActionNode* action = basket->getAction())
-        {
-            delete action;
-        }
+        if (child + 1 < size && Before(heap[child + 1], heap[child]))
+            ++child;
 
-        delete basket;
+        if (!Before(heap[child], entry))
+            break;
+
+        Place(pos, heap[child]);
+        pos = child;
     }
+
+    Place(pos, entry);
+}
+
+void Queue::RemoveAt(uint32 pos)
+{
+    slots.erase(heap[pos].id);
+
+    Entry last = heap.back();
+    heap.pop_back();
+    if (pos >= heap.size())
+        return;
+
+    Place(pos, last);
+    SiftDown(pos);
+    SiftUp(pos);
 }
@@ -6,13 +6,18 @@
 #ifndef _PLAYERBOT_QUEUE_H
 #define _PLAYERBOT_QUEUE_H
 
+#include <unordered_map>
+
 #include "Action.h"
 #include "Common.h"
 
+// Max-heap of action baskets ordered by relevance (ties go to the earliest pushed basket).
+// Each action name has at most one basket; slots maps its interned id to the heap position. A queue only
+// ever holds a few dozen baskets, so the map stays small no matter how many names have been interned.
 class Queue
 {
 public:
-    Queue(void) {}
+    Queue(void) : pushed(0) {}
     ~Queue(void) {}
 
     void Push(ActionBasket* action);
@@ -22,7 +27,22 @@ public:
     void RemoveExpired();
 
 private:
-    std::list<ActionBasket*> actions;
+    struct Entry
+    {
+        ActionBasket* basket;
+        NameId id;
+        uint32 order;
+    };
+
+    bool Before(Entry const& left, Entry const& right) const;
+    void Place(uint32 pos, Entry const& entry);
+    void SiftUp(uint32 pos);
+    void SiftDown(uint32 pos);
+    void RemoveAt(uint32 pos);
+
+    std::vector<Entry> heap;
+    std::unordered_map<NameId, uint32> slots;  // heap position of every queued action
+    uint32 pushed;
 };
 
 #endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "StrategyGraph.h"
+
+#include <typeinfo>
+
+#include "AiObjectContext.h"
+#include "CustomStrategy.h"
+#include "Strategy.h"
+
+StrategyGraph::StrategyGraph(std::map<std::string, Strategy*>& strategies)
+{
+    for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
+    {
+        Strategy* strategy = i->second;
+        strategy->InitTriggers(triggers);
+        defaultActions.push_back(strategy->getDefaultActions());
+    }
+}
+
+StrategyGraph::~StrategyGraph()
+{
+    for (std::vector<TriggerNode*>::iterator i = triggers.begin(); i != triggers.end(); i++)
+        delete *i;
+
+    for (std::vector<NextAction**>::iterator i = defaultActions.begin(); i != defaultActions.end(); i++)
+        NextAction::destroy(*i);
+
+    for (std::unordered_map<NameId, ActionNode*>::iterator i = actionNodes.begin(); i != actionNodes.end(); i++)
+        delete i->second;
+}
+
+ActionNode* StrategyGraph::GetActionNode(NameId id, std::map<std::string, Strategy*>& strategies)
+{
+    {
+        std::shared_lock<std::shared_mutex> guard(actionNodesLock);
+        std::unordered_map<NameId, ActionNode*>::iterator i = actionNodes.find(id);
+        if (i != actionNodes.end())
+            return i->second;
+    }
+
+    ActionNode* node = CreateActionNode(sNamedObjectRegistry->GetName(id), strategies);
+
+    std::unique_lock<std::shared_mutex> guard(actionNodesLock);
+    std::pair<std::unordered_map<NameId, ActionNode*>::iterator, bool> inserted = actionNodes.emplace(id, node);
+    if (!inserted.second)
+        delete node;
+
+    return inserted.first->second;
+}
+
+ActionNode* StrategyGraph::CreateActionNode(std::string const& name, std::map<std::string, Strategy*>& strategies)
+{
+    for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
+    {
+        if (ActionNode* node = i->second->GetAction(name))
+            return node;
+    }
+
+    return new ActionNode(name,
+                          /*P*/ nullptr,
+                          /*A*/ nullptr,
+                          /*C*/ nullptr);
+}
+
+std::shared_ptr<StrategyGraph> StrategyGraphCache::Get(AiObjectContext* context,
+                                                       std::map<std::string, Strategy*>& strategies)
+{
+    // class contexts register different strategies under the same names (e.g. "pull")
+    std::string key = typeid(*context).name();
+    for (std::map<std::string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
+    {
+        // custom strategies load their action lines per bot
+        if (dynamic_cast<CustomStrategy*>(i->second))
+            return std::make_shared<StrategyGraph>(strategies);
+
+        key += "|";
+        key += i->first;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        std::unordered_map<std::string, std::weak_ptr<StrategyGraph>>::iterator i = graphs.find(key);
+        if (i != graphs.end())
+        {
+            if (std::shared_ptr<StrategyGraph> graph = i->second.lock())
+                return graph;
+        }
+    }
+
+    std::shared_ptr<StrategyGraph> graph = std::make_shared<StrategyGraph>(strategies);
+
+    std::lock_guard<std::mutex> guard(lock);
+    std::weak_ptr<StrategyGraph>& cached = graphs[key];
+    if (std::shared_ptr<StrategyGraph> existing = cached.lock())
+        return existing;
+
+    // drop combinations no engine uses any more
+    for (std::unordered_map<std::string, std::weak_ptr<StrategyGraph>>::iterator i = graphs.begin();
+         i != graphs.end();)
+    {
+        if (i->second.expired() && i->first != key)
+            i = graphs.erase(i);
+        else
+            ++i;
+    }
+
+    cached = graph;
+    return graph;
+}
+
+void StrategyGraphCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    graphs.clear();
+}
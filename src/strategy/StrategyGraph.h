@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_STRATEGYGRAPH_H
+#define _PLAYERBOT_STRATEGYGRAPH_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.h"
+#include "NamedObjectRegistry.h"
+
+class ActionNode;
+class AiObjectContext;
+class NextAction;
+class Strategy;
+class TriggerNode;
+
+// Trigger nodes and action node templates compiled from one combination of strategies.
+// A graph is never modified after compilation except for lazily filling the action node table,
+// so every engine running the same combination shares one instance.
+class StrategyGraph
+{
+public:
+    StrategyGraph(std::map<std::string, Strategy*>& strategies);
+    virtual ~StrategyGraph();
+
+    std::vector<TriggerNode*> const& GetTriggers() { return triggers; }
+    std::vector<NextAction**> const& GetDefaultActions() { return defaultActions; }
+    // strategies must be the combination the graph was compiled from
+    ActionNode* GetActionNode(NameId id, std::map<std::string, Strategy*>& strategies);
+
+    static ActionNode* CreateActionNode(std::string const& name, std::map<std::string, Strategy*>& strategies);
+
+private:
+    std::vector<TriggerNode*> triggers;
+    std::vector<NextAction**> defaultActions;
+    std::unordered_map<NameId, ActionNode*> actionNodes;
+    std::shared_mutex actionNodesLock;
+};
+
+class StrategyGraphCache
+{
+public:
+    StrategyGraphCache(){};
+    virtual ~StrategyGraphCache(){};
+    static StrategyGraphCache* instance()
+    {
+        static StrategyGraphCache instance;
+        return &instance;
+    }
+
+public:
+    std::shared_ptr<StrategyGraph> Get(AiObjectContext* context, std::map<std::string, Strategy*>& strategies);
+    void Clear();
+
+private:
+    std::unordered_map<std::string, std::weak_ptr<StrategyGraph>> graphs;
+    std::mutex lock;
+};
+
+#define sStrategyGraphCache StrategyGraphCache::instance()
+
+#endif
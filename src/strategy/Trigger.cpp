@@ -12,7 +12,9 @@
 Trigger::Trigger(PlayerbotAI* botAI, std::string const name, int32 checkInterval)
     : AiNamedObject(botAI, name),
       checkInterval(checkInterval == 1 ? 1 : (checkInterval < 100 ? checkInterval * 1000 : checkInterval)),
-      lastCheckTime(0)
+      lastCheckTime(0),
+      eventSource(0),
+      triggered(false)
 {
 }
 
@@ -20,12 +22,13 @@ Event Trigger::Check()
 {
     if (IsActive())
     {
-        Event event(getName());
-        return event;
+        if (!eventSource)
+            eventSource = sNamedObjectRegistry->Intern(getName());
+
+        return Event(eventSource);
     }
 
-    Event event;
-    return event;
+    return Event();
 }
 
 Value<Unit*>* Trigger::GetTargetValue() { return context->GetValue<Unit*>(GetTargetName()); }
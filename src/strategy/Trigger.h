@@ -12,6 +12,14 @@
 class PlayerbotAI;
 class Unit;
 
+// What a trigger reads, so the engine can skip checks while none of it changed
+enum TriggerInput
+{
+    TRIGGER_INPUT_ANY,         // unknown, checked whenever its interval allows
+    TRIGGER_INPUT_EXTERNAL,    // packets and commands, checked only after ExternalEvent
+    TRIGGER_INPUT_SELF_STATE   // health, power and death state of the bot itself
+};
+
 class Trigger : public AiNamedObject
 {
 public:
@@ -21,8 +29,11 @@ public:
 
     virtual Event Check();
     virtual void ExternalEvent([[maybe_unused]] std::string const param, [[maybe_unused]] Player* owner = nullptr) {}
-    virtual void ExternalEvent([[maybe_unused]] WorldPacket& packet, [[maybe_unused]] Player* owner = nullptr) {}
+    virtual void ExternalEvent([[maybe_unused]] WorldPacket const& packet, [[maybe_unused]] Player* owner = nullptr)
+    {
+    }
     virtual bool IsActive() { return false; }
+    virtual TriggerInput GetInput() { return TRIGGER_INPUT_ANY; }
     virtual NextAction** getHandlers() { return nullptr; }
     void Update() {}
     virtual void Reset() {}
@@ -31,17 +42,22 @@ public:
     virtual std::string const GetTargetName() { return "self target"; }
 
     bool needCheck();
+    bool HasInterval() const { return checkInterval >= 2; }
+    uint32 GetNextCheckTime() const { return lastCheckTime + checkInterval; }
+    bool IsTriggered() const { return triggered; }
 
 protected:
     int32 checkInterval;
     uint32 lastCheckTime;
+    NameId eventSource;
+    bool triggered;  // an external event arrived since the last reset
 };
 
 class TriggerNode
 {
 public:
     TriggerNode(std::string const name, NextAction** handlers = nullptr)
-        : trigger(nullptr), handlers(handlers), name(name)
+        : trigger(nullptr), handlers(handlers), name(name), id(sNamedObjectRegistry->Intern(name))
     {
     }  // reorder args - whipowill
 
@@ -50,8 +66,13 @@ public:
     Trigger* getTrigger() { return trigger; }
     void setTrigger(Trigger* trigger) { this->trigger = trigger; }
     std::string const getName() { return name; }
+    NameId getId() { return id; }
 
-    NextAction** getHandlers() { return NextAction::merge(NextAction::clone(handlers), trigger->getHandlers()); }
+    NextAction** getHandlers() { return getHandlers(trigger); }
+    NextAction** getHandlers(Trigger* trigger)
+    {
+        return NextAction::merge(NextAction::clone(handlers), trigger->getHandlers());
+    }
 
     float getFirstRelevance() { return handlers[0] ? handlers[0]->getRelevance() : -1; }
 
@@ -59,6 +80,7 @@ private:
     Trigger* trigger;
     NextAction** handlers;
     std::string const name;
+    NameId const id;
 };
 
 #endif
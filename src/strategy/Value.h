@@ -8,7 +8,12 @@
 
 #include <time.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include "AiObject.h"
+#include "Log.h"
 #include "ObjectGuid.h"
 #include "PerformanceMonitor.h"
 #include "Timer.h"
@@ -165,6 +170,58 @@ public:
     }
 };
 
+// Value calculated once from world data and read by every bot through SharedValueContext.
+// Readers get an immutable snapshot without taking a lock; Reset drops it so the next read rebuilds it,
+// while readers still holding the old snapshot keep it alive.
+template <class T>
+class SharedCalculatedValue : public UntypedValue, public Value<T>
+{
+public:
+    SharedCalculatedValue(PlayerbotAI* botAI, std::string const name = "value") : UntypedValue(botAI, name) {}
+
+    std::shared_ptr<T const> GetSnapshot()
+    {
+        std::shared_ptr<T const> snapshot = std::atomic_load(&this->snapshot);
+        if (snapshot)
+            return snapshot;
+
+        std::lock_guard<std::mutex> guard(buildLock);
+        snapshot = std::atomic_load(&this->snapshot);
+        if (!snapshot)
+        {
+            PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName());
+            snapshot = std::make_shared<T const>(Calculate());
+            if (pmo)
+                pmo->finish();
+
+            std::atomic_store(&this->snapshot, snapshot);
+        }
+
+        return snapshot;
+    }
+
+    T Get() override { return *GetSnapshot(); }
+    T LazyGet() override { return *GetSnapshot(); }
+    // A reference into the snapshot would dangle once it is replaced and would let one bot change what every
+    // other thread reads, so shared values only hand out a private copy. Use GetSnapshot to read in place.
+    T& RefGet() override
+    {
+        LOG_ERROR("playerbots", "RefGet is not supported on shared value {}, use its snapshot", this->getName());
+        thread_local T copy;
+        copy = *GetSnapshot();
+        return copy;
+    }
+    void Set(T val) override { std::atomic_store(&snapshot, std::make_shared<T const>(val)); }
+    void Reset() override { std::atomic_store(&snapshot, std::shared_ptr<T const>()); }
+
+protected:
+    virtual T Calculate() = 0;
+
+private:
+    std::shared_ptr<T const> snapshot;
+    std::mutex buildLock;
+};
+
 template <class T>
 class MemoryCalculatedValue : public CalculatedValue<T>
 {
@@ -60,7 +60,7 @@ bool AcceptQuestAction::Execute(Event event)
     }
     else
     {
-        WorldPacket& p = event.getPacket();
+        WorldPacket p(event.getPacket());
         p.rpos(0);
         p >> guid >> quest;
     }
@@ -80,7 +80,7 @@ bool AcceptQuestShareAction::Execute(Event event)
     Player* master = GetMaster();
     Player* bot = botAI->GetBot();
 
-    WorldPacket& p = event.getPacket();
+    WorldPacket p(event.getPacket());
     p.rpos(0);
     uint32 quest;
     p >> quest;
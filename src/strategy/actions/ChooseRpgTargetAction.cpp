@@ -5,7 +5,10 @@
 
 #include "ChooseRpgTargetAction.h"
 
+#include <algorithm>
+#include <mutex>
 #include <random>
+#include <typeinfo>
 
 #include "BattlegroundMgr.h"
 #include "BudgetValues.h"
@@ -47,45 +50,56 @@ bool ChooseRpgTargetAction::HasSameTarget(ObjectGuid guid, uint32 max, GuidVecto
     return num > 0;
 }
 
-float ChooseRpgTargetAction::getMaxRelevance(GuidPosition guidP)
+std::vector<RpgTriggerRelevance> const& ChooseRpgTargetAction::GetRelevanceTable(Strategy* strategy)
 {
-    GuidPosition currentRpgTarget = AI_VALUE(GuidPosition, "rpg target");
-    SET_AI_VALUE(GuidPosition, "rpg target", guidP);
+    static std::unordered_map<std::string, std::vector<RpgTriggerRelevance>> tables;
+    static std::mutex lock;
 
-    Strategy* rpgStrategy = botAI->GetAiObjectContext()->GetStrategy("rpg");
+    std::lock_guard<std::mutex> guard(lock);
 
-    std::vector<TriggerNode*> triggerNodes;
-    rpgStrategy->InitTriggers(triggerNodes);
+    // class contexts may register different strategies under the same name
+    std::string const key = typeid(*strategy).name();
+    std::unordered_map<std::string, std::vector<RpgTriggerRelevance>>::iterator i = tables.find(key);
+    if (i != tables.end())
+        return i->second;
 
-    float maxRelevance = 0.0f;
+    std::vector<TriggerNode*> triggerNodes;
+    strategy->InitTriggers(triggerNodes);
 
-    for (auto& triggerNode : triggerNodes)
+    std::vector<RpgTriggerRelevance> table;
+    for (TriggerNode* triggerNode : triggerNodes)
     {
-        Trigger* trigger = context->GetTrigger(triggerNode->getName());
-        if (trigger)
-        {
-            triggerNode->setTrigger(trigger);
+        float relevance = triggerNode->getFirstRelevance();
+        if (relevance >= 0.0f && relevance <= 2.0f)
+            table.push_back(RpgTriggerRelevance{triggerNode->getId(), relevance});
 
-            if (triggerNode->getFirstRelevance() < maxRelevance || triggerNode->getFirstRelevance() > 2.0f)
-                continue;
+        delete triggerNode;
+    }
 
-            trigger = triggerNode->getTrigger();
-            if (!trigger->IsActive())
-                continue;
+    std::stable_sort(table.begin(), table.end(), [](RpgTriggerRelevance const& left, RpgTriggerRelevance const& right)
+                     { return left.relevance > right.relevance; });
 
-            maxRelevance = triggerNode->getFirstRelevance();
-        }
-    }
+    return tables.emplace(key, table).first->second;
+}
 
-    SET_AI_VALUE(GuidPosition, "rpg target", currentRpgTarget);
+float ChooseRpgTargetAction::getMaxRelevance(GuidPosition guidP)
+{
+    GuidPosition currentRpgTarget = AI_VALUE(GuidPosition, "rpg target");
+    SET_AI_VALUE(GuidPosition, "rpg target", guidP);
 
-    for (std::vector<TriggerNode*>::iterator i = triggerNodes.begin(); i != triggerNodes.end(); i++)
+    // the table is ordered by relevance, so the first active trigger is the most relevant one
+    float maxRelevance = 0.0f;
+    for (RpgTriggerRelevance const& entry : GetRelevanceTable(context->GetStrategy("rpg")))
     {
-        TriggerNode* trigger = *i;
-        delete trigger;
+        Trigger* trigger = context->GetTrigger(entry.trigger);
+        if (trigger && trigger->IsActive())
+        {
+            maxRelevance = entry.relevance;
+            break;
+        }
     }
 
-    triggerNodes.clear();
+    SET_AI_VALUE(GuidPosition, "rpg target", currentRpgTarget);
 
     return (maxRelevance - 1.0) * 1000.0f;
 }
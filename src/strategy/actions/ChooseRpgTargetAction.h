@@ -6,15 +6,24 @@
 #ifndef _PLAYERBOT_CHOOSERPGTARGETACTION_H
 #define _PLAYERBOT_CHOOSERPGTARGETACTION_H
 
+#include "NamedObjectRegistry.h"
 #include "ObjectGuid.h"
 #include "RpgAction.h"
 
 class GuidPosition;
 class Player;
 class PlayerbotAI;
+class Strategy;
 class WorldObject;
 class WorldPosition;
 
+// A trigger of the rpg strategy and the relevance of the first action it starts
+struct RpgTriggerRelevance
+{
+    NameId trigger;
+    float relevance;
+};
+
 class ChooseRpgTargetAction : public Action
 {
 public:
@@ -27,6 +36,7 @@ public:
     static bool isFollowValid(Player* bot, WorldPosition pos);
 
 private:
+    static std::vector<RpgTriggerRelevance> const& GetRelevanceTable(Strategy* strategy);
     float getMaxRelevance(GuidPosition guidP);
     bool HasSameTarget(ObjectGuid guid, uint32 max, GuidVector const& nearGuids);
 };
@@ -699,15 +699,15 @@ std::vector<TravelDestination*> TravelMgr::getBossTravelDestinations(Player* bot
 
     std::vector<TravelDestination*> retTravelLocations;
 
-    for (auto& dest : bossMobs)
+    for (auto& dest : bossMobIndex.getCandidates(botLocation, maxDistance))
     {
-        if (!ignoreInactive && !dest->isActive(bot))
+        if (maxDistance > 0 && dest->distanceTo(&botLocation) > maxDistance)
             continue;
 
         if (dest->isFull(ignoreFull))
             continue;
 
-        if (maxDistance > 0 && dest->distanceTo(&botLocation) > maxDistance)
+        if (!ignoreInactive && !dest->isActive(bot))
             continue;
 
         retTravelLocations.push_back(dest);
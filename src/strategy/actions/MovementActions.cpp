@@ -5,6 +5,7 @@
 
 #include "MovementActions.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iomanip>
@@ -23,6 +24,7 @@
 #include "MovementGenerator.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
+#include "PathCache.h"
 #include "PathGenerator.h"
 #include "PlayerbotAIConfig.h"
 #include "Playerbots.h"
@@ -120,10 +122,30 @@ bool MovementAction::MoveToLOS(WorldObject* target, bool ranged)
     float y = target->GetPositionY();
     float z = target->GetPositionZ();
 
-    // Use standard PathGenerator to find a route.
-    PathGenerator path(bot);
-    path.CalculatePath(x, y, z, false);
-    PathType type = path.GetPathType();
+    // Use standard PathGenerator to find a route, or the one another bot just found.
+    PathCacheEntry path;
+    bool cacheable = PathCache::IsCacheable(bot);
+    PathCacheKey key(bot, x, y, z, PATH_CACHE_LOS_PATH);
+    if (cacheable && sPathCache->Find(bot->GetMapId(), key, path))
+    {
+        // the cached path led to another point of the same cell
+        path.path.back() = G3D::Vector3(x, y, z);
+    }
+    else
+    {
+        PathGenerator gen(bot);
+        gen.CalculatePath(x, y, z, false);
+        path.path = gen.GetPath();
+        path.type = gen.GetPathType();
+        path.z = z;
+        path.time = getMSTime();
+
+        // failed searches are not shared, the next bot may find a way
+        if (cacheable && !path.path.empty() && (path.type == PATHFIND_NORMAL || path.type == PATHFIND_INCOMPLETE))
+            sPathCache->Store(bot->GetMapId(), key, path);
+    }
+
+    PathType type = path.type;
     if (type != PATHFIND_NORMAL && type != PATHFIND_INCOMPLETE)
         return false;
 
@@ -133,9 +155,9 @@ bool MovementAction::MoveToLOS(WorldObject* target, bool ranged)
     float dist = FLT_MAX;
     PositionInfo dest;
 
-    if (!path.GetPath().empty())
+    if (!path.path.empty())
     {
-        for (auto& point : path.GetPath())
+        for (auto& point : path.path)
         {
             if (botAI->HasStrategy("debug move", BOT_STATE_NON_COMBAT))
                 CreateWp(bot, point.x, point.y, point.z, 0.0, 2334);
@@ -1586,6 +1608,35 @@ bool MovementAction::MoveInside(uint32 mapId, float x, float y, float z, float d
 
 const Movement::PointsArray MovementAction::SearchForBestPath(float x, float y, float z, float& modified_z,
                                                               int maxSearchCount, bool normal_only, float step)
+{
+    PathCacheEntry entry;
+    if (!PathCache::IsCacheable(bot))
+        return CalculateBestPath(x, y, z, modified_z, entry.type, maxSearchCount, normal_only, step);
+
+    uint32 params = (normal_only ? 1 : 0) | (uint32(maxSearchCount) & 0xFF) << 1 | uint32(step * 10.0f) << 9;
+    PathCacheKey key(bot, x, y, z, PATH_CACHE_BEST_PATH, params);
+    if (sPathCache->Find(bot->GetMapId(), key, entry))
+    {
+        // the cached path led to another point of the same cell
+        entry.path.back() = G3D::Vector3(x, y, entry.z);
+        modified_z = entry.z;
+        return entry.path;
+    }
+
+    entry.path = CalculateBestPath(x, y, z, modified_z, entry.type, maxSearchCount, normal_only, step);
+    entry.z = modified_z;
+    entry.time = getMSTime();
+
+    // failed searches are not shared, the next bot may find a way
+    if (!entry.path.empty() && modified_z != INVALID_HEIGHT)
+        sPathCache->Store(bot->GetMapId(), key, entry);
+
+    return entry.path;
+}
+
+const Movement::PointsArray MovementAction::CalculateBestPath(float x, float y, float z, float& modified_z,
+                                                              PathType& type, int maxSearchCount, bool normal_only,
+                                                              float step)
 {
     bool found = false;
     modified_z = INVALID_HEIGHT;
@@ -1593,6 +1644,7 @@ const Movement::PointsArray MovementAction::SearchForBestPath(float x, float y,
     PathGenerator gen(bot);
     gen.CalculatePath(x, y, tempZ);
     Movement::PointsArray result = gen.GetPath();
+    type = gen.GetPathType();
     float min_length = gen.getPathLength();
     int typeOk = PATHFIND_NORMAL | PATHFIND_INCOMPLETE;
     if ((gen.GetPathType() & typeOk) && abs(tempZ - z) < 0.5f)
@@ -1606,31 +1658,27 @@ const Movement::PointsArray MovementAction::SearchForBestPath(float x, float y,
         modified_z = tempZ;
         found = true;
     }
-    int count = 1;
-    for (float delta = step; count < maxSearchCount / 2 + 1; count++, delta += step)
-    {
-        tempZ = bot->GetMapHeight(x, y, z + delta);
-        if (tempZ == INVALID_HEIGHT)
-        {
-            continue;
-        }
-        PathGenerator gen(bot);
-        gen.CalculatePath(x, y, tempZ);
-        if ((gen.GetPathType() & typeOk) && gen.getPathLength() < min_length)
-        {
-            found = true;
-            min_length = gen.getPathLength();
-            result = gen.GetPath();
-            modified_z = tempZ;
-        }
-    }
-    for (float delta = -step; count < maxSearchCount; count++, delta -= step)
+
+    // probes above the destination mostly land on a floor already tried
+    std::vector<float> triedZ;
+    triedZ.reserve(maxSearchCount);
+    triedZ.push_back(tempZ);
+
+    // first half of the probes upwards, the rest downwards
+    float delta = step;
+    for (int count = 1; count < maxSearchCount; count++)
     {
+        if (count == maxSearchCount / 2 + 1)
+            delta = -step;
+
         tempZ = bot->GetMapHeight(x, y, z + delta);
-        if (tempZ == INVALID_HEIGHT)
+        delta += delta > 0 ? step : -step;
+        if (tempZ == INVALID_HEIGHT || std::find(triedZ.begin(), triedZ.end(), tempZ) != triedZ.end())
         {
             continue;
         }
+        triedZ.push_back(tempZ);
+
         PathGenerator gen(bot);
         gen.CalculatePath(x, y, tempZ);
         if ((gen.GetPathType() & typeOk) && gen.getPathLength() < min_length)
@@ -1638,12 +1686,18 @@ const Movement::PointsArray MovementAction::SearchForBestPath(float x, float y,
             found = true;
             min_length = gen.getPathLength();
             result = gen.GetPath();
+            type = gen.GetPathType();
             modified_z = tempZ;
+
+            // as close to the requested height as the first try would have accepted
+            if (abs(tempZ - z) < 0.5f)
+                break;
         }
     }
     if (!found && normal_only)
     {
         modified_z = INVALID_HEIGHT;
+        type = PATHFIND_NOPATH;
         return Movement::PointsArray{};
     }
     if (!found && !normal_only)
@@ -65,6 +65,8 @@ private:
     // normal_only = false, float step = 8.0f);
     const Movement::PointsArray SearchForBestPath(float x, float y, float z, float& modified_z, int maxSearchCount = 5,
                                                   bool normal_only = false, float step = 8.0f);
+    const Movement::PointsArray CalculateBestPath(float x, float y, float z, float& modified_z, PathType& type,
+                                                  int maxSearchCount, bool normal_only, float step);
 };
 
 class FleeAction : public MovementAction
@@ -18,7 +18,7 @@ bool QueryItemUsageAction::Execute(Event event)
     if (!sPlayerbotAIConfig->sayWhenCollectingItems)
         return false;
 
-    WorldPacket& data = event.getPacket();
+    WorldPacket data(event.getPacket());
     if (!data.empty())
     {
         data.rpos(0);
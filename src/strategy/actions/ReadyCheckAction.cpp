@@ -145,7 +145,7 @@ public:
 
 bool ReadyCheckAction::Execute(Event event)
 {
-    WorldPacket& p = event.getPacket();
+    WorldPacket p(event.getPacket());
     ObjectGuid player;
     p.rpos(0);
     if (!p.empty())
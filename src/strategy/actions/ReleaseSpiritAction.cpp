@@ -27,7 +27,7 @@ bool ReleaseSpiritAction::Execute(Event event)
         return false;
     }
 
-    WorldPacket& p = event.getPacket();
+    WorldPacket const& p = event.getPacket();
     if (!p.empty() && p.GetOpcode() == CMSG_REPOP_REQUEST)
         botAI->TellMasterNoFacing("Releasing...");
     else
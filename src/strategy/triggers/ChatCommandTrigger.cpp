@@ -8,14 +8,13 @@
 #include "Playerbots.h"
 
 ChatCommandTrigger::ChatCommandTrigger(PlayerbotAI* botAI, std::string const command)
-    : Trigger(botAI, command), triggered(false), owner(nullptr)
+    : Trigger(botAI, command)
 {
 }
 
 void ChatCommandTrigger::ExternalEvent(std::string const paramName, Player* eventPlayer)
 {
-    param = paramName;
-    owner = eventPlayer;
+    event = Event(getName(), paramName, eventPlayer);
     triggered = true;
 }
 
@@ -24,7 +23,11 @@ Event ChatCommandTrigger::Check()
     if (!triggered)
         return Event();
 
-    return Event(getName(), param, owner);
+    return event;
 }
 
-void ChatCommandTrigger::Reset() { triggered = false; }
+void ChatCommandTrigger::Reset()
+{
+    triggered = false;
+    event = Event();
+}
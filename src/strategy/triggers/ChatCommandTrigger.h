@@ -19,12 +19,11 @@ public:
 
     void ExternalEvent(std::string const param, Player* owner = nullptr) override;
     Event Check() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_EXTERNAL; }
     void Reset() override;
 
 private:
-    std::string param;
-    bool triggered;
-    Player* owner;
+    Event event;
 };
 
 #endif
@@ -32,6 +32,7 @@ public:
     HighManaTrigger(PlayerbotAI* botAI) : Trigger(botAI, "high mana") {}
 
     bool IsActive() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_SELF_STATE; }
 };
 
 class EnoughManaTrigger : public Trigger
@@ -40,6 +41,7 @@ public:
     EnoughManaTrigger(PlayerbotAI* botAI) : Trigger(botAI, "enough mana") {}
 
     bool IsActive() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_SELF_STATE; }
 };
 
 class AlmostFullManaTrigger : public Trigger
@@ -48,6 +50,7 @@ public:
     AlmostFullManaTrigger(PlayerbotAI* botAI) : Trigger(botAI, "almost full mana") {}
 
     bool IsActive() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_SELF_STATE; }
 };
 
 class RageAvailable : public StatAvailable
@@ -56,6 +59,7 @@ public:
     RageAvailable(PlayerbotAI* botAI, int32 amount) : StatAvailable(botAI, amount, "rage available") {}
 
     bool IsActive() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_SELF_STATE; }
 };
 
 class LightRageAvailableTrigger : public RageAvailable
@@ -82,6 +86,7 @@ public:
     EnergyAvailable(PlayerbotAI* botAI, int32 amount) : StatAvailable(botAI, amount, "energy available") {}
 
     bool IsActive() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_SELF_STATE; }
 };
 
 class LightEnergyAvailableTrigger : public EnergyAvailable
@@ -470,6 +475,7 @@ public:
     LowManaTrigger(PlayerbotAI* botAI) : Trigger(botAI, "low mana") {}
 
     bool IsActive() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_SELF_STATE; }
 };
 
 class MediumManaTrigger : public Trigger
@@ -478,6 +484,7 @@ public:
     MediumManaTrigger(PlayerbotAI* botAI) : Trigger(botAI, "medium mana") {}
 
     bool IsActive() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_SELF_STATE; }
 };
 
 BEGIN_TRIGGER(PanicTrigger, Trigger)
@@ -54,6 +54,7 @@ public:
     }
 
     std::string const GetTargetName() override { return "self target"; }
+    TriggerInput GetInput() override { return TRIGGER_INPUT_SELF_STATE; }
 };
 
 class CriticalHealthTrigger : public LowHealthTrigger
@@ -7,10 +7,9 @@
 
 #include "Playerbots.h"
 
-void WorldPacketTrigger::ExternalEvent(WorldPacket& revData, Player* eventOwner)
+void WorldPacketTrigger::ExternalEvent(WorldPacket const& revData, Player* eventOwner)
 {
-    packet = revData;
-    owner = eventOwner;
+    event = Event(getName(), revData, eventOwner);
     triggered = true;
 }
 
@@ -19,7 +18,11 @@ Event WorldPacketTrigger::Check()
     if (!triggered)
         return Event();
 
-    return Event(getName(), packet, owner);
+    return event;
 }
 
-void WorldPacketTrigger::Reset() { triggered = false; }
+void WorldPacketTrigger::Reset()
+{
+    triggered = false;
+    event = Event();
+}
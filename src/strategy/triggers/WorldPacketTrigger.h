@@ -16,16 +16,15 @@ class WorldPacket;
 class WorldPacketTrigger : public Trigger
 {
 public:
-    WorldPacketTrigger(PlayerbotAI* botAI, std::string const command) : Trigger(botAI, command), triggered(false) {}
+    WorldPacketTrigger(PlayerbotAI* botAI, std::string const command) : Trigger(botAI, command) {}
 
-    void ExternalEvent(WorldPacket& packet, Player* owner = nullptr) override;
+    void ExternalEvent(WorldPacket const& packet, Player* owner = nullptr) override;
     Event Check() override;
+    TriggerInput GetInput() override { return TRIGGER_INPUT_EXTERNAL; }
     void Reset() override;
 
 private:
-    WorldPacket packet;
-    bool triggered;
-    Player* owner;
+    Event event;
 };
 
 #endif
@@ -99,7 +99,7 @@ std::vector<int32> ItemDropListValue::Calculate()
 {
     uint32 itemId = stoi(getQualifier());
 
-    DropMap* dropMap = GAI_VALUE(DropMap*, "drop map");
+    DropMap* dropMap = *GAI_SNAPSHOT(DropMap*, "drop map");
 
     std::vector<int32> entries;
 
@@ -137,7 +137,9 @@ itemUsageMap EntryLootUsageValue::Calculate()
 {
     itemUsageMap items;
 
-    for (auto itemId : GAI_VALUE2(std::vector<uint32>, "entry loot list", getQualifier()))
+    std::shared_ptr<std::vector<uint32> const> lootList =
+        GAI_SNAPSHOT2(std::vector<uint32>, "entry loot list", getQualifier());
+    for (uint32 itemId : *lootList)
     {
         items[AI_VALUE2(ItemUsage, "item usage", itemId)].push_back(itemId);
     }
@@ -27,10 +27,10 @@ public:
 typedef std::unordered_map<uint32, int32> DropMap;
 
 // Returns the loot map of all entries
-class DropMapValue : public SingleCalculatedValue<DropMap*>
+class DropMapValue : public SharedCalculatedValue<DropMap*>
 {
 public:
-    DropMapValue(PlayerbotAI* botAI) : SingleCalculatedValue(botAI, "drop map") {}
+    DropMapValue(PlayerbotAI* botAI) : SharedCalculatedValue(botAI, "drop map") {}
 
     static LootTemplateAccess const* GetLootTemplate(ObjectGuid guid, LootType type = LOOT_CORPSE);
 
@@ -38,19 +38,19 @@ public:
 };
 
 // Returns the entries that drop a specific item
-class ItemDropListValue : public SingleCalculatedValue<std::vector<int32>>, public Qualified
+class ItemDropListValue : public SharedCalculatedValue<std::vector<int32>>, public Qualified
 {
 public:
-    ItemDropListValue(PlayerbotAI* botAI) : SingleCalculatedValue(botAI, "item drop list") {}
+    ItemDropListValue(PlayerbotAI* botAI) : SharedCalculatedValue(botAI, "item drop list") {}
 
     std::vector<int32> Calculate() override;
 };
 
 // Returns the items a specific entry can drop
-class EntryLootListValue : public SingleCalculatedValue<std::vector<uint32>>, public Qualified
+class EntryLootListValue : public SharedCalculatedValue<std::vector<uint32>>, public Qualified
 {
 public:
-    EntryLootListValue(PlayerbotAI* botAI) : SingleCalculatedValue(botAI, "entry loot list") {}
+    EntryLootListValue(PlayerbotAI* botAI) : SharedCalculatedValue(botAI, "entry loot list") {}
 
     std::vector<uint32> Calculate() override;
 };
@@ -31,10 +31,13 @@ public:
     BgRoleValue(PlayerbotAI* botAI) : ManualSetValue<uint32>(botAI, 0, "bg role") {}
 };
 
-class BgMastersValue : public SingleCalculatedValue<std::vector<CreatureData const*>>, public Qualified
+class BgMastersValue : public SharedCalculatedValue<std::vector<CreatureData const*>>, public Qualified
 {
 public:
-    BgMastersValue(PlayerbotAI* botAI) : SingleCalculatedValue<std::vector<CreatureData const*>>(botAI, "bg masters") {}
+    BgMastersValue(PlayerbotAI* botAI)
+        : SharedCalculatedValue<std::vector<CreatureData const*>>(botAI, "bg masters")
+    {
+    }
 
     std::vector<CreatureData const*> Calculate() override;
 };
@@ -45,7 +45,9 @@ entryQuestRelationMap EntryQuestRelationMapValue::Calculate()
             // Loot objective
             if (quest->RequiredItemId[objective])
             {
-                for (auto& entry : GAI_VALUE2(std::vector<int32>, "item drop list", quest->RequiredItemId[objective]))
+                std::shared_ptr<std::vector<int32> const> entries =
+                    GAI_SNAPSHOT2(std::vector<int32>, "item drop list", quest->RequiredItemId[objective]);
+                for (int32 entry : *entries)
                     rMap[entry][questId] |= relationFlag;
             }
         }
@@ -57,7 +59,7 @@ entryQuestRelationMap EntryQuestRelationMapValue::Calculate()
 // Get all the objective entries for a specific quest.
 void FindQuestObjectData::GetObjectiveEntries()
 {
-    relationMap = GAI_VALUE(entryQuestRelationMap, "entry quest relation");
+    relationMap = GAI_SNAPSHOT(entryQuestRelationMap, "entry quest relation");
 }
 
 // Data worker. Checks for a specific creature what quest they are needed for and puts them in the proper place in the
@@ -66,7 +68,11 @@ void FindQuestObjectData::operator()(CreatureData const& creData)
 {
     uint32 entry = creData.id1;
 
-    for (auto& relation : relationMap[entry])
+    entryQuestRelationMap::const_iterator relations = relationMap->find(entry);
+    if (relations == relationMap->end())
+        return;
+
+    for (auto const& relation : relations->second)
     {
         uint32 questId = relation.first;
         uint32 flag = relation.second;
@@ -80,7 +86,11 @@ void FindQuestObjectData::operator()(GameObjectData const& goData)
 {
     int32 entry = goData.id * -1;
 
-    for (auto& relation : relationMap[entry])
+    entryQuestRelationMap::const_iterator relations = relationMap->find(entry);
+    if (relations == relationMap->end())
+        return;
+
+    for (auto const& relation : relations->second)
     {
         uint32 questId = relation.first;
         uint32 flag = relation.second;
@@ -110,13 +120,17 @@ questGiverMap QuestGiversValue::Calculate()
     if (hasQualifier)
         level = stoi(q);
 
-    questGuidpMap questMap = GAI_VALUE(questGuidpMap, "quest guidp map");
+    std::shared_ptr<questGuidpMap const> questMap = GAI_SNAPSHOT(questGuidpMap, "quest guidp map");
 
     questGiverMap guidps;
 
-    for (auto& qPair : questMap)
+    for (auto& qPair : *questMap)
     {
-        for (auto& entry : qPair.second[(int)QuestRelationFlag::questGiver])
+        auto qg = qPair.second.find((int)QuestRelationFlag::questGiver);
+        if (qg == qPair.second.end())
+            continue;
+
+        for (auto& entry : qg->second)
         {
             for (auto& guidp : entry.second)
             {
@@ -140,11 +154,11 @@ questGiverMap QuestGiversValue::Calculate()
 
 std::vector<GuidPosition> ActiveQuestGiversValue::Calculate()
 {
-    questGiverMap qGivers = GAI_VALUE2(questGiverMap, "quest givers", bot->GetLevel());
+    std::shared_ptr<questGiverMap const> qGivers = GAI_SNAPSHOT2(questGiverMap, "quest givers", bot->GetLevel());
 
     std::vector<GuidPosition> retQuestGivers;
 
-    for (auto& qGiver : qGivers)
+    for (auto& qGiver : *qGivers)
     {
         uint32 questId = qGiver.first;
         Quest const* quest = sObjectMgr->GetQuestTemplate(questId);
@@ -161,7 +175,7 @@ std::vector<GuidPosition> ActiveQuestGiversValue::Calculate()
         if (status != QUEST_STATUS_NONE)
             continue;
 
-        for (auto& guidp : qGiver.second)
+        for (GuidPosition guidp : qGiver.second)
         {
             CreatureTemplate const* creatureTemplate = guidp.GetCreatureTemplate();
 
@@ -185,7 +199,7 @@ std::vector<GuidPosition> ActiveQuestGiversValue::Calculate()
 
 std::vector<GuidPosition> ActiveQuestTakersValue::Calculate()
 {
-    questGuidpMap questMap = GAI_VALUE(questGuidpMap, "quest guidp map");
+    std::shared_ptr<questGuidpMap const> questMap = GAI_SNAPSHOT(questGuidpMap, "quest guidp map");
 
     std::vector<GuidPosition> retQuestTakers;
 
@@ -207,9 +221,9 @@ std::vector<GuidPosition> ActiveQuestTakersValue::Calculate()
             (!quest->IsAutoComplete() || !bot->CanTakeQuest(quest, false)))
             continue;
 
-        auto q = questMap.find(questId);
+        auto q = questMap->find(questId);
 
-        if (q == questMap.end())
+        if (q == questMap->end())
             continue;
 
         auto qt = q->second.find((int)QuestRelationFlag::questTaker);
@@ -229,7 +243,7 @@ std::vector<GuidPosition> ActiveQuestTakersValue::Calculate()
                 }
             }
 
-            for (auto& guidp : entry.second)
+            for (GuidPosition guidp : entry.second)
             {
                 if (guidp.isDead())
                     continue;
@@ -244,7 +258,7 @@ std::vector<GuidPosition> ActiveQuestTakersValue::Calculate()
 
 std::vector<GuidPosition> ActiveQuestObjectivesValue::Calculate()
 {
-    questGuidpMap questMap = GAI_VALUE(questGuidpMap, "quest guidp map");
+    std::shared_ptr<questGuidpMap const> questMap = GAI_SNAPSHOT(questGuidpMap, "quest guidp map");
 
     std::vector<GuidPosition> retQuestObjectives;
 
@@ -284,9 +298,9 @@ std::vector<GuidPosition> ActiveQuestObjectivesValue::Calculate()
                     continue;
             }
 
-            auto q = questMap.find(questId);
+            auto q = questMap->find(questId);
 
-            if (q == questMap.end())
+            if (q == questMap->end())
                 continue;
 
             auto qt = q->second.find((int)QuestRelationFlag(1 << objective));
@@ -296,7 +310,7 @@ std::vector<GuidPosition> ActiveQuestObjectivesValue::Calculate()
 
             for (auto& entry : qt->second)
             {
-                for (auto& guidp : entry.second)
+                for (GuidPosition guidp : entry.second)
                 {
                     if (guidp.isDead())
                         continue;
@@ -46,10 +46,10 @@ typedef std::unordered_map<uint32, questRelationGuidps> questGuidpMap;
 typedef std::unordered_map<uint32, std::vector<GuidPosition>> questGiverMap;
 
 // Returns the quest relation Flags for all entries and quests
-class EntryQuestRelationMapValue : public SingleCalculatedValue<entryQuestRelationMap>
+class EntryQuestRelationMapValue : public SharedCalculatedValue<entryQuestRelationMap>
 {
 public:
-    EntryQuestRelationMapValue(PlayerbotAI* botAI) : SingleCalculatedValue(botAI, "entry quest relation map") {}
+    EntryQuestRelationMapValue(PlayerbotAI* botAI) : SharedCalculatedValue(botAI, "entry quest relation map") {}
 
     entryQuestRelationMap Calculate() override;
 };
@@ -69,25 +69,25 @@ private:
     std::unordered_map<int32, std::vector<std::pair<uint32, QuestRelationFlag>>> entryMap;
     std::unordered_map<uint32, std::vector<std::pair<uint32, QuestRelationFlag>>> itemMap;
 
-    entryQuestRelationMap relationMap;
+    std::shared_ptr<entryQuestRelationMap const> relationMap;
 
     questGuidpMap data;
 };
 
 // All objects to start, do or finish a quest.
-class QuestGuidpMapValue : public SingleCalculatedValue<questGuidpMap>
+class QuestGuidpMapValue : public SharedCalculatedValue<questGuidpMap>
 {
 public:
-    QuestGuidpMapValue(PlayerbotAI* botAI) : SingleCalculatedValue(botAI, "quest guidp map") {}
+    QuestGuidpMapValue(PlayerbotAI* botAI) : SharedCalculatedValue(botAI, "quest guidp map") {}
 
     questGuidpMap Calculate() override;
 };
 
 // All questgivers and their quests that are Useful for a specific level
-class QuestGiversValue : public SingleCalculatedValue<questGiverMap>, public Qualified
+class QuestGiversValue : public SharedCalculatedValue<questGiverMap>, public Qualified
 {
 public:
-    QuestGiversValue(PlayerbotAI* botAI) : SingleCalculatedValue(botAI, "quest givers") {}
+    QuestGiversValue(PlayerbotAI* botAI) : SharedCalculatedValue(botAI, "quest givers") {}
 
     questGiverMap Calculate() override;
 };
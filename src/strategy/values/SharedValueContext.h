@@ -6,6 +6,9 @@
 #ifndef _PLAYERBOT_SHAREDVALUECONTEXT_H
 #define _PLAYERBOT_SHAREDVALUECONTEXT_H
 
+#include <memory>
+#include <shared_mutex>
+
 #include "LootValues.h"
 #include "NamedObjectContext.h"
 #include "Playerbots.h"
@@ -47,15 +50,49 @@ public:
         return &instance;
     }
 
+    using NamedObjectContext<UntypedValue>::create;
+
+    // Bots on every map thread resolve shared values, and every value is created once for the shared
+    // PlayerbotAI rather than for whichever bot asked first.
+    UntypedValue* create(NameId id, PlayerbotAI* /*botAI*/) override
+    {
+        {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            std::unordered_map<NameId, UntypedValue*>::iterator i = created.find(id);
+            if (i != created.end())
+                return i->second;
+        }
+
+        std::unique_lock<std::shared_mutex> guard(lock);
+        std::unordered_map<NameId, UntypedValue*>::iterator i = created.find(id);
+        if (i != created.end())
+            return i->second;
+
+        return created[id] = NamedObjectFactory<UntypedValue>::create(sNamedObjectRegistry->GetName(id), &sharedBotAI);
+    }
+
+    std::set<std::string> GetCreated() override
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        return NamedObjectContext<UntypedValue>::GetCreated();
+    }
+
+    // Drops the snapshots of a value, with every qualifier, after the data it is built from changed
+    void Rebuild(std::string const name)
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        for (std::unordered_map<NameId, UntypedValue*>::iterator i = created.begin(); i != created.end(); ++i)
+        {
+            std::string const createdName = sNamedObjectRegistry->GetName(i->first);
+            if (i->second && (createdName == name || createdName.rfind(name + "::", 0) == 0))
+                i->second->Reset();
+        }
+    }
+
     template <class T>
     Value<T>* getGlobalValue(std::string const name)
     {
-        NamedObjectContextList<UntypedValue> valueContexts;
-        valueContexts.Add(this);
-        PlayerbotAI* botAI = new PlayerbotAI();
-        UntypedValue* value = valueContexts.GetContextObject(name, botAI);
-        delete botAI;
-        return dynamic_cast<Value<T>*>(value);
+        return dynamic_cast<Value<T>*>(create(name, &sharedBotAI));
     }
 
     template <class T>
@@ -71,6 +108,32 @@ public:
         out << param;
         return getGlobalValue<T>(name, out.str());
     }
+
+    // The current snapshot of a shared value, read without copying it
+    template <class T>
+    std::shared_ptr<T const> getGlobalSnapshot(std::string const name)
+    {
+        SharedCalculatedValue<T>* value = dynamic_cast<SharedCalculatedValue<T>*>(create(name, &sharedBotAI));
+        return value ? value->GetSnapshot() : std::make_shared<T const>();
+    }
+
+    template <class T>
+    std::shared_ptr<T const> getGlobalSnapshot(std::string const name, std::string const param)
+    {
+        return getGlobalSnapshot<T>(std::string(name) + "::" + param);
+    }
+
+    template <class T>
+    std::shared_ptr<T const> getGlobalSnapshot(std::string const name, uint32 param)
+    {
+        std::ostringstream out;
+        out << param;
+        return getGlobalSnapshot<T>(name, out.str());
+    }
+
+private:
+    PlayerbotAI sharedBotAI;
+    std::shared_mutex lock;
 };
 
 #define sSharedValueContext SharedValueContext::instance()